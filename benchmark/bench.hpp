@@ -0,0 +1,85 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Bench {
+
+// Number of calls made to the global operator new since the process started.
+std::size_t allocation_count();
+
+struct Result {
+	std::string name;
+	std::size_t iterations;
+	double ns_per_iteration;
+	double allocations_per_iteration;
+	std::map<std::string, double> counters;
+};
+
+class State {
+public:
+	explicit State(std::string name);
+
+	/**
+	 * Times `iterations` calls of func and records the wall time and heap allocations
+	 * per call. Calling it again replaces the previous measurement.
+	 */
+	template<class Func>
+	void run(std::size_t iterations, Func func) {
+		const auto allocations_before = allocation_count();
+		const auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < iterations; i++) {
+			func();
+		}
+		const auto stop = std::chrono::steady_clock::now();
+		const auto allocations = allocation_count() - allocations_before;
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+		m_result.iterations = iterations;
+		m_result.ns_per_iteration = static_cast<double>(elapsed) / static_cast<double>(iterations);
+		m_result.allocations_per_iteration = static_cast<double>(allocations) / static_cast<double>(iterations);
+	}
+
+	void counter(const std::string& name, double value);
+
+	const Result& result() const;
+
+private:
+	Result m_result;
+};
+
+using Function = std::function<void(State&)>;
+
+struct Registrar {
+	Registrar(const std::string& name, Function func);
+};
+
+std::vector<std::pair<std::string, Function>>& registry();
+
+// Keeps the optimizer from discarding a value that is only computed for timing.
+template<class T>
+inline void do_not_optimize(const T& value) {
+#if defined(_MSC_VER)
+	static const volatile void* sink = nullptr;
+	sink = &value;
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+}
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+#define BENCHMARK_CASE(name, state)                                                                                                                            \
+	static void BENCH_CONCAT(bench_func_, __LINE__)(Bench::State & state);                                                                                      \
+	static const Bench::Registrar BENCH_CONCAT(bench_registrar_, __LINE__)(name, BENCH_CONCAT(bench_func_, __LINE__));                                       \
+	static void BENCH_CONCAT(bench_func_, __LINE__)(Bench::State & state)
+
+#endif // BENCH_HPP
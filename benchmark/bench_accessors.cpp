@@ -0,0 +1,50 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <cstddef>
+#include <libdbc/dbc.hpp>
+#include <sstream>
+
+static Libdbc::DbcParser& accessor_parser() {
+	static Libdbc::DbcParser parser;
+	static bool parsed = false;
+	if (!parsed) {
+		std::istringstream stream(Bench::generate_dbc(Bench::DbcOptions{200, 8}));
+		parser.parse_file(stream);
+		parsed = true;
+	}
+	return parser;
+}
+
+BENCHMARK_CASE("accessors/iterate_all_signals", state) {
+	const auto& parser = accessor_parser();
+
+	state.run(1000, [&parser]() {
+		std::size_t count = 0;
+		for (const auto& message : parser.get_messages()) {
+			for (const auto& signal : message.get_signals()) {
+				count += signal.receivers.size();
+			}
+		}
+		Bench::do_not_optimize(count);
+	});
+	state.counter("messages", static_cast<double>(parser.get_messages().size()));
+}
+
+BENCHMARK_CASE("accessors/nodes_and_unused_lines", state) {
+	const auto& parser = accessor_parser();
+
+	state.run(100000, [&parser]() {
+		std::size_t count = parser.get_nodes().size() + parser.unused_lines().size();
+		Bench::do_not_optimize(count);
+	});
+}
+
+BENCHMARK_CASE("accessors/find_message_and_signal", state) {
+	const auto& parser = accessor_parser();
+
+	state.run(1000, [&parser]() {
+		const auto* message = parser.find_message("MSG_250");
+		const auto* signal = message->find_signal("SIG_250_7");
+		Bench::do_not_optimize(signal);
+	});
+}
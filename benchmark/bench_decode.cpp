@@ -0,0 +1,200 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <cstddef>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/fixed_point.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+struct Traffic {
+	Bench::DbcOptions options;
+	Libdbc::DbcParser parser;
+	std::vector<Bench::Frame> frames;
+
+	explicit Traffic(const Bench::DbcOptions& dbc_options)
+		: options(dbc_options) {
+		std::istringstream stream(Bench::generate_dbc(options));
+		parser.parse_file(stream);
+		frames = Bench::generate_frames(options, 4096);
+	}
+};
+
+}
+
+static Traffic& classic_traffic() {
+	static Traffic traffic(Bench::DbcOptions{500, 8, 0, 0, false});
+	return traffic;
+}
+
+BENCHMARK_CASE("lookup/message_by_id", state) {
+	const auto& traffic = classic_traffic();
+
+	std::size_t next = 0;
+	state.run(1000000, [&traffic, &next]() {
+		const auto* message = traffic.parser.find_message(traffic.frames[next++ & 4095].id);
+		Bench::do_not_optimize(message);
+	});
+}
+
+BENCHMARK_CASE("lookup/message_by_name", state) {
+	const auto& traffic = classic_traffic();
+
+	std::vector<std::string> names;
+	for (const auto& frame : traffic.frames) {
+		names.push_back(traffic.parser.find_message(frame.id)->name());
+	}
+
+	std::size_t next = 0;
+	state.run(1000000, [&traffic, &names, &next]() {
+		const auto* message = traffic.parser.find_message(names[next++ & 4095]);
+		Bench::do_not_optimize(message);
+	});
+}
+
+BENCHMARK_CASE("lookup/signal_by_qualified_name", state) {
+	const auto& traffic = classic_traffic();
+
+	std::vector<std::string> names;
+	for (const auto& frame : traffic.frames) {
+		const auto* message = traffic.parser.find_message(frame.id);
+		names.push_back(message->name() + "." + message->get_signals().back().name);
+	}
+
+	std::size_t next = 0;
+	state.run(1000000, [&traffic, &names, &next]() {
+		const auto handle = traffic.parser.find_signal_handle(names[next++ & 4095]);
+		Bench::do_not_optimize(handle);
+	});
+}
+
+BENCHMARK_CASE("decode/per_frame", state) {
+	auto& traffic = classic_traffic();
+
+	std::vector<double> values;
+	std::size_t next = 0;
+	state.run(1000000, [&traffic, &values, &next]() {
+		const auto& frame = traffic.frames[next++ & 4095];
+		values.clear();
+		traffic.parser.parse_message(frame.id, frame.data, values);
+		Bench::do_not_optimize(values.data());
+	});
+	state.counter("signals_per_frame", static_cast<double>(traffic.options.signals_per_message));
+}
+
+// Decodes the whole frame buffer per iteration, either one parse_message call per frame or one batch
+static std::vector<Libdbc::Frame> batch_frames(const Traffic& traffic) {
+	std::vector<Libdbc::Frame> frames;
+	for (const auto& frame : traffic.frames) {
+		frames.push_back(Libdbc::Frame{frame.id, frame.data.data(), frame.data.size(), 0});
+	}
+	return frames;
+}
+
+BENCHMARK_CASE("decode/batch_per_frame", state) {
+	auto& traffic = classic_traffic();
+
+	std::vector<double> values;
+	state.run(200, [&traffic, &values]() {
+		values.clear();
+		for (const auto& frame : traffic.frames) {
+			traffic.parser.parse_message(frame.id, frame.data, values);
+		}
+		Bench::do_not_optimize(values.data());
+	});
+	state.counter("frames_per_iteration", static_cast<double>(traffic.frames.size()));
+}
+
+static void run_batch(Bench::State& state, Libdbc::BatchOrder order) {
+	auto& traffic = classic_traffic();
+	const auto frames = batch_frames(traffic);
+
+	Libdbc::BatchResult result;
+	state.run(200, [&traffic, &frames, &result, order]() {
+		traffic.parser.parse_batch(frames, result, order);
+		Bench::do_not_optimize(result.values.data());
+	});
+	state.counter("frames_per_iteration", static_cast<double>(frames.size()));
+}
+
+BENCHMARK_CASE("decode/batch_original_order", state) {
+	run_batch(state, Libdbc::BatchOrder::Original);
+}
+
+BENCHMARK_CASE("decode/batch_grouped", state) {
+	run_batch(state, Libdbc::BatchOrder::Grouped);
+}
+
+// Same as batch_original_order with every value checked against its signal's [min|max]
+BENCHMARK_CASE("decode/batch_range_check", state) {
+	auto& traffic = classic_traffic();
+	traffic.parser.enable_range_check();
+	run_batch(state, Libdbc::BatchOrder::Original);
+	traffic.parser.enable_range_check(false);
+}
+
+// Byte aligned fields read straight from the payload against the shift and mask path for every signal
+static Traffic& mixed_traffic() {
+	static Traffic traffic(Bench::DbcOptions{500, 0, 0, 0, false, 0, true});
+	return traffic;
+}
+
+BENCHMARK_CASE("decode/layouts_generic", state) {
+	const auto& traffic = mixed_traffic();
+	const auto& plans = traffic.parser.get_decode_plans();
+
+	std::vector<double> values(16);
+	std::size_t next = 0;
+	state.run(1000000, [&traffic, &plans, &values, &next]() {
+		const auto& frame = traffic.frames[next++ & 4095];
+		const auto& plan = plans[frame.id - Bench::message_id(0)];
+		const auto words = Libdbc::PayloadWords::load(frame.data.data(), frame.data.size());
+		double* out = values.data();
+		for (const auto& signal : plan.signals()) {
+			*out++ = signal.decode(words);
+		}
+		Bench::do_not_optimize(values.data());
+	});
+}
+
+BENCHMARK_CASE("decode/layouts_fast_paths", state) {
+	const auto& traffic = mixed_traffic();
+	const auto& plans = traffic.parser.get_decode_plans();
+
+	std::vector<double> values(16);
+	std::size_t next = 0;
+	state.run(1000000, [&traffic, &plans, &values, &next]() {
+		const auto& frame = traffic.frames[next++ & 4095];
+		plans[frame.id - Bench::message_id(0)].decode(frame.data.data(), frame.data.size(), values.data());
+		Bench::do_not_optimize(values.data());
+	});
+
+	std::size_t aligned = 0;
+	for (const auto& signal : plans.front().signals()) {
+		aligned += signal.layout != Libdbc::SignalPlan::Layout::Generic ? 1 : 0;
+	}
+	state.counter("aligned_signals", static_cast<double>(aligned));
+	state.counter("signals", static_cast<double>(plans.front().signals().size()));
+}
+
+// Integer only decode of the mixed layouts, compare with decode/layouts_fast_paths
+BENCHMARK_CASE("decode/fixed_point", state) {
+	const auto& traffic = mixed_traffic();
+
+	std::vector<Libdbc::FixedPointPlan> plans;
+	for (const auto& message : traffic.parser.get_messages()) {
+		plans.emplace_back(message);
+	}
+
+	std::vector<int64_t> values(16);
+	std::size_t next = 0;
+	state.run(1000000, [&traffic, &plans, &values, &next]() {
+		const auto& frame = traffic.frames[next++ & 4095];
+		plans[frame.id - Bench::message_id(0)].decode(frame.data.data(), frame.data.size(), values.data());
+		Bench::do_not_optimize(values.data());
+	});
+	state.counter("inexact_signals", static_cast<double>(plans.front().inexact_signals().size()));
+}
@@ -0,0 +1,116 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/signal_export.hpp>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <vector>
+
+namespace {
+
+// Counts what is written and throws it away, so only the formatting and encoding is measured
+class CountingBuffer : public std::streambuf {
+public:
+	std::size_t bytes = 0;
+
+protected:
+	int_type overflow(int_type ch) override {
+		bytes++;
+		return traits_type::not_eof(ch);
+	}
+
+	std::streamsize xsputn(const char*, std::streamsize count) override {
+		bytes += static_cast<std::size_t>(count);
+		return count;
+	}
+};
+
+// One decoded batch of 4096 frames, each frame 10 ms after the previous one
+struct DecodedBatch {
+	Libdbc::DbcParser parser;
+	std::vector<Bench::Frame> frames;
+	std::vector<Libdbc::Frame> batch;
+	Libdbc::BatchResult result;
+
+	DecodedBatch() {
+		const Bench::DbcOptions options{100, 8, 0, 0, false};
+		std::istringstream stream(Bench::generate_dbc(options));
+		parser.parse_file(stream);
+		frames = Bench::generate_frames(options, 4096);
+		for (std::size_t i = 0; i < frames.size(); i++) {
+			batch.push_back(Libdbc::Frame{frames[i].id, frames[i].data.data(), frames[i].data.size(), i * 10000000});
+		}
+		parser.parse_batch(batch, result);
+	}
+};
+
+}
+
+static DecodedBatch& decoded_batch() {
+	static DecodedBatch batch;
+	return batch;
+}
+
+static void report(Bench::State& state, const CountingBuffer& buffer, std::size_t iterations) {
+	const auto values = decoded_batch().result.values.size();
+	state.counter("values_per_iteration", static_cast<double>(values));
+	state.counter("bytes_per_value", static_cast<double>(buffer.bytes) / static_cast<double>(values * iterations));
+}
+
+// What the exporters replace: one iostream insertion per value
+BENCHMARK_CASE("export/csv_iostream", state) {
+	auto& batch = decoded_batch();
+	const auto& messages = batch.parser.get_messages();
+	CountingBuffer buffer;
+	std::ostream out(&buffer);
+	out.precision(17);
+
+	state.run(20, [&batch, &messages, &out]() {
+		for (const auto& decoded : batch.result.frames) {
+			const auto& signals = messages[decoded.message_index].get_signals();
+			for (std::size_t i = 0; i < decoded.value_count; i++) {
+				out << batch.batch[decoded.frame_index].timestamp_ns << ',' << messages[decoded.message_index].name() << '.' << signals[i].name << ','
+					<< batch.result.values[decoded.first_value + i] << '\n';
+			}
+		}
+	});
+	report(state, buffer, 20);
+}
+
+BENCHMARK_CASE("export/csv", state) {
+	auto& batch = decoded_batch();
+	CountingBuffer buffer;
+	std::ostream out(&buffer);
+	Libdbc::CsvWriter writer(batch.parser, out);
+
+	state.run(20, [&batch, &writer]() {
+		writer.write(batch.batch, batch.result);
+	});
+	writer.flush();
+	report(state, buffer, 20);
+}
+
+static void run_columnar(Bench::State& state, Libdbc::ColumnEncoding encoding) {
+	auto& batch = decoded_batch();
+	CountingBuffer buffer;
+	std::ostream out(&buffer);
+	Libdbc::ColumnarWriter writer(batch.parser, out, encoding);
+
+	state.run(20, [&batch, &writer]() {
+		writer.write(batch.batch, batch.result);
+	});
+	writer.flush();
+	report(state, buffer, 20);
+}
+
+BENCHMARK_CASE("export/columnar_plain", state) {
+	run_columnar(state, Libdbc::ColumnEncoding::Plain);
+}
+
+BENCHMARK_CASE("export/columnar_compressed", state) {
+	run_columnar(state, Libdbc::ColumnEncoding::Compressed);
+}
@@ -0,0 +1,86 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <libdbc/dbc.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/gateway.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Two databases with the same messages, the destination's signals optionally scaled differently
+struct Buses {
+	Bench::DbcOptions options;
+	Libdbc::DbcParser source;
+	Libdbc::DbcParser destination;
+	std::vector<Bench::Frame> frames;
+
+	Buses(const Bench::DbcOptions& dbc_options, bool same_scaling)
+		: options(dbc_options) {
+		const auto text = Bench::generate_dbc(options);
+		std::istringstream source_stream(text);
+		source.parse_file(source_stream);
+
+		auto destination_text = text;
+		if (!same_scaling) {
+			for (auto pos = destination_text.find("(0.1,0)"); pos != std::string::npos; pos = destination_text.find("(0.1,0)", pos)) {
+				destination_text.replace(pos, 7, "(0.2,0)");
+			}
+		}
+		std::istringstream destination_stream(destination_text);
+		destination.parse_file(destination_stream);
+
+		frames = Bench::generate_frames(options, 4096);
+	}
+};
+
+}
+
+static void run_gateway(Bench::State& state, bool same_scaling) {
+	static const Bench::DbcOptions options{200, 8, 0, 0, false};
+	Buses buses(options, same_scaling);
+
+	Libdbc::Gateway gateway(buses.source, buses.destination);
+	for (const auto& message : buses.source.get_messages()) {
+		for (const auto& signal : message.get_signals()) {
+			const auto name = message.name() + "." + signal.name;
+			gateway.add_route(name, name);
+		}
+	}
+
+	std::vector<Libdbc::Frame> out;
+	out.reserve(4);
+	std::size_t next = 0;
+	state.run(1000000, [&buses, &gateway, &out, &next]() {
+		const auto& frame = buses.frames[next++ & 4095];
+		out.clear();
+		gateway.route(Libdbc::Frame{frame.id, frame.data.data(), frame.data.size(), 0}, out);
+		Bench::do_not_optimize(out.data());
+	});
+
+	// Worst single frame, timed one by one so it includes the clock overhead
+	long long worst_ns = 0;
+	for (const auto& frame : buses.frames) {
+		const auto start = std::chrono::steady_clock::now();
+		out.clear();
+		gateway.route(Libdbc::Frame{frame.id, frame.data.data(), frame.data.size(), 0}, out);
+		const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		worst_ns = std::max<long long>(worst_ns, elapsed);
+	}
+
+	state.counter("routes", static_cast<double>(gateway.route_count()));
+	state.counter("direct_routes", static_cast<double>(gateway.direct_route_count()));
+	state.counter("worst_frame_ns", static_cast<double>(worst_ns));
+}
+
+BENCHMARK_CASE("gateway/direct_moves", state) {
+	run_gateway(state, true);
+}
+
+BENCHMARK_CASE("gateway/converted", state) {
+	run_gateway(state, false);
+}
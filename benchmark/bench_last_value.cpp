@@ -0,0 +1,80 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/last_value_store.hpp>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+static void run_contention(Bench::State& state, std::size_t reader_count) {
+	Libdbc::DbcParser parser;
+	std::istringstream stream(Bench::generate_dbc(Bench::DbcOptions{200, 8}));
+	parser.parse_file(stream);
+
+	Libdbc::LastValueStore store(parser);
+	parser.add_observer(store);
+
+	// Dashboards poll a handful of signals spread over the database
+	std::vector<Libdbc::SignalHandle> handles;
+	for (std::size_t msg = 0; msg < parser.get_messages().size(); msg += 4) {
+		handles.push_back(Libdbc::SignalHandle(msg, 0));
+	}
+
+	std::atomic<bool> running{true};
+	std::atomic<uint64_t> snapshots{0};
+	std::vector<std::thread> readers;
+	for (std::size_t i = 0; i < reader_count; i++) {
+		readers.emplace_back([&store, &handles, &running, &snapshots]() {
+			std::vector<Libdbc::LastValueStore::Sample> samples;
+			uint64_t count = 0;
+			while (running.load(std::memory_order_relaxed)) {
+				store.snapshot(handles, samples);
+				count++;
+			}
+			snapshots.fetch_add(count);
+		});
+	}
+
+	const std::size_t frames = 1000000;
+	const auto& messages = parser.get_messages();
+	std::vector<uint8_t> data(8, 0);
+	std::vector<double> values;
+	values.reserve(16);
+
+	const auto start = std::chrono::steady_clock::now();
+	std::size_t index = 0;
+	state.run(frames, [&]() {
+		data[0] = static_cast<uint8_t>(index);
+		values.clear();
+		parser.parse_message(messages[index % messages.size()].id(), data, values, index);
+		index++;
+	});
+	const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	running = false;
+	for (auto& reader : readers) {
+		reader.join();
+	}
+
+	state.counter("readers", static_cast<double>(reader_count));
+	state.counter("signals_per_snapshot", static_cast<double>(handles.size()));
+	state.counter("snapshots_per_second", static_cast<double>(snapshots.load()) / elapsed);
+	state.counter("read_retries", static_cast<double>(store.read_retries()));
+	state.counter("retries_per_snapshot", snapshots.load() == 0 ? 0 : static_cast<double>(store.read_retries()) / static_cast<double>(snapshots.load()));
+}
+
+BENCHMARK_CASE("last_value/writer_only", state) {
+	run_contention(state, 0);
+}
+
+BENCHMARK_CASE("last_value/writer_with_1_reader", state) {
+	run_contention(state, 1);
+}
+
+BENCHMARK_CASE("last_value/writer_with_4_readers", state) {
+	run_contention(state, 4);
+}
@@ -0,0 +1,92 @@
+#include "bench.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+std::atomic<std::size_t> allocations{0};
+}
+
+void* operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+namespace Bench {
+
+std::size_t allocation_count() {
+	return allocations.load(std::memory_order_relaxed);
+}
+
+State::State(std::string name)
+	: m_result{std::move(name), 0, 0, 0, {}} {
+}
+
+void State::counter(const std::string& name, double value) {
+	m_result.counters[name] = value;
+}
+
+const Result& State::result() const {
+	return m_result;
+}
+
+Registrar::Registrar(const std::string& name, Function func) {
+	registry().emplace_back(name, std::move(func));
+}
+
+std::vector<std::pair<std::string, Function>>& registry() {
+	static std::vector<std::pair<std::string, Function>> benchmarks;
+	return benchmarks;
+}
+
+}
+
+static void write_json(std::ostream& out, const std::vector<Bench::Result>& results) {
+	out << "{\n  \"benchmarks\": [";
+	for (std::size_t i = 0; i < results.size(); i++) {
+		const auto& result = results[i];
+		out << (i == 0 ? "\n" : ",\n");
+		out << "    {\"name\": \"" << result.name << "\", ";
+		out << "\"iterations\": " << result.iterations << ", ";
+		out << "\"ns_per_iteration\": " << result.ns_per_iteration << ", ";
+		out << "\"allocations_per_iteration\": " << result.allocations_per_iteration;
+		for (const auto& counter : result.counters) {
+			out << ", \"" << counter.first << "\": " << counter.second;
+		}
+		out << "}";
+	}
+	out << "\n  ]\n}\n";
+}
+
+// Usage: dbcBenchmarks [name filter]
+int main(int argc, char** argv) {
+	const std::string filter = argc > 1 ? argv[1] : "";
+
+	std::vector<Bench::Result> results;
+	for (const auto& benchmark : Bench::registry()) {
+		if (benchmark.first.find(filter) == std::string::npos) {
+			continue;
+		}
+		Bench::State state(benchmark.first);
+		benchmark.second(state);
+		results.push_back(state.result());
+	}
+
+	write_json(std::cout, results);
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <cstddef>
+#include <libdbc/database_image.hpp>
+#include <libdbc/dbc.hpp>
+#include <sstream>
+#include <string>
+
+static void run_parse(Bench::State& state, const Bench::DbcOptions& options, std::size_t iterations) {
+	const std::string dbc = Bench::generate_dbc(options);
+
+	Libdbc::DbcParser parser;
+	state.run(iterations, [&parser, &dbc]() {
+		std::istringstream stream(dbc);
+		parser.parse_file(stream);
+	});
+
+	state.counter("messages", static_cast<double>(parser.get_messages().size()));
+	state.counter("unused_lines", static_cast<double>(parser.unused_lines().size()));
+	state.counter("file_bytes", static_cast<double>(dbc.size()));
+}
+
+BENCHMARK_CASE("parse/small", state) {
+	run_parse(state, Bench::DbcOptions{50, 4, 0, 0, false}, 50);
+}
+
+BENCHMARK_CASE("parse/large", state) {
+	run_parse(state, Bench::DbcOptions{1000, 8, 0, 0, false}, 3);
+}
+
+// What a process attaching to a shared image pays at startup instead of parse/large
+BENCHMARK_CASE("parse/image_attach", state) {
+	const std::string dbc = Bench::generate_dbc(Bench::DbcOptions{1000, 8, 0, 0, false});
+	Libdbc::DbcParser parser;
+	std::istringstream stream(dbc);
+	parser.parse_file(stream);
+	const auto image = Libdbc::DatabaseImage::build(parser, 1);
+
+	Libdbc::DatabaseView view;
+	state.run(1000, [&view, &image]() {
+		view.attach(image.data(), image.size());
+		Bench::do_not_optimize(&view);
+	});
+
+	state.counter("messages", static_cast<double>(view.message_count()));
+	state.counter("image_bytes", static_cast<double>(image.size()));
+}
+
+BENCHMARK_CASE("parse/value_descriptions", state) {
+	run_parse(state, Bench::DbcOptions{200, 8, 8, 0, false}, 5);
+}
+
+BENCHMARK_CASE("parse/multiplexed", state) {
+	run_parse(state, Bench::DbcOptions{200, 4, 0, 8, false}, 5);
+}
+
+BENCHMARK_CASE("parse/can_fd", state) {
+	run_parse(state, Bench::DbcOptions{200, 32, 0, 0, true}, 5);
+}
+
+// Memory held by the parsed database, as accounted by the parse report
+static void run_memory(Bench::State& state, const Bench::DbcOptions& options) {
+	const std::string dbc = Bench::generate_dbc(options);
+
+	Libdbc::DbcParser parser;
+	parser.enable_parse_report();
+	state.run(1, [&parser, &dbc]() {
+		std::istringstream stream(dbc);
+		parser.parse_file(stream);
+	});
+
+	const auto& report = parser.get_parse_report();
+	state.counter("message_bytes", static_cast<double>(report.message_bytes));
+	state.counter("signal_bytes", static_cast<double>(report.signal_bytes));
+	state.counter("string_bytes", static_cast<double>(report.string_bytes));
+	state.counter("value_description_bytes", static_cast<double>(report.value_description_bytes));
+	state.counter("index_bytes", static_cast<double>(report.index_bytes));
+	state.counter("total_bytes", static_cast<double>(report.total_bytes()));
+}
+
+BENCHMARK_CASE("memory/large", state) {
+	run_memory(state, Bench::DbcOptions{1000, 8, 0, 0, false});
+}
+
+BENCHMARK_CASE("memory/value_descriptions", state) {
+	run_memory(state, Bench::DbcOptions{200, 8, 8, 0, false});
+}
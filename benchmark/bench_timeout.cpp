@@ -0,0 +1,56 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_observer.hpp>
+#include <libdbc/timeout_monitor.hpp>
+#include <sstream>
+
+static constexpr uint64_t MS = 1000000;
+
+static Libdbc::DbcParser& periodic_parser() {
+	static Libdbc::DbcParser parser;
+	static bool parsed = false;
+	if (!parsed) {
+		std::istringstream stream(Bench::generate_dbc(Bench::DbcOptions{3000, 1, 0, 0, false, 10}));
+		parser.parse_file(stream);
+		parsed = true;
+	}
+	return parser;
+}
+
+// Every message arrives once per 10 ms cycle, each arrival pushes its deadline out
+BENCHMARK_CASE("timeout/arrival", state) {
+	const auto& parser = periodic_parser();
+	Libdbc::TimeoutMonitor monitor(parser, [](const Libdbc::TimeoutMonitor::Timeout&) {});
+
+	const double value = 0;
+	Libdbc::DecodedMessage decoded{nullptr, 0, &value, 1, MS};
+	const std::size_t message_count = parser.get_messages().size();
+	state.run(3000000, [&monitor, &decoded, message_count]() {
+		decoded.message_index = (decoded.message_index + 1) % message_count;
+		decoded.timestamp_ns += 10 * MS / message_count;
+		monitor.on_decoded(decoded);
+	});
+	state.counter("messages", static_cast<double>(message_count));
+}
+
+BENCHMARK_CASE("timeout/advance_all_expiring", state) {
+	const auto& parser = periodic_parser();
+	std::size_t timeouts = 0;
+	Libdbc::TimeoutMonitor monitor(parser, [&timeouts](const Libdbc::TimeoutMonitor::Timeout&) {
+		timeouts++;
+	});
+
+	uint64_t now = MS;
+	state.run(100, [&monitor, &now]() {
+		monitor.arm_all(now);
+		// 30 ms timeouts, stepped one tick at a time until every one of them fired
+		for (int tick = 0; tick < 31; tick++) {
+			now += MS;
+			monitor.advance(now);
+		}
+	});
+	state.counter("timeouts", static_cast<double>(timeouts));
+}
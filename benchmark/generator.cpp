@@ -0,0 +1,90 @@
+#include "generator.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Bench {
+
+static std::size_t payload_size(const DbcOptions& options) {
+	return options.can_fd && !options.mixed_layouts ? 64 : 8;
+}
+
+// start|size@order(sign) of the mixed layout, filling exactly 8 bytes
+static const char* const MIXED_LAYOUT[] = {
+	"0|8@1+",
+	"8|16@1+",
+	"31|16@0-",
+	"40|4@1+",
+	"44|12@1-",
+	"63|8@0+",
+};
+
+uint32_t message_id(std::size_t index) {
+	return static_cast<uint32_t>(100 + index);
+}
+
+std::string generate_dbc(const DbcOptions& options) {
+	std::string dbc = "VERSION \"1.0.0\"\n\nNS_ :\n\nBS_:\n\nBU_: ECU1 ECU2 ECU3\n\n";
+
+	const std::size_t payload_bits = payload_size(options) * 8;
+	const std::size_t signal_size = std::min<std::size_t>(32, payload_bits / std::max<std::size_t>(options.signals_per_message, 1));
+	std::string value_lines;
+	std::string attribute_lines;
+	for (std::size_t msg = 0; msg < options.messages; msg++) {
+		const auto id = std::to_string(message_id(msg));
+		dbc += "BO_ " + id + " MSG_" + id + ": " + std::to_string(payload_size(options)) + " ECU1\n";
+		const std::size_t signal_count = options.mixed_layouts ? sizeof(MIXED_LAYOUT) / sizeof(MIXED_LAYOUT[0]) : options.signals_per_message;
+		for (std::size_t sig = 0; sig < signal_count; sig++) {
+			const auto name = "SIG_" + id + "_" + std::to_string(sig);
+			const auto layout = options.mixed_layouts ? std::string(MIXED_LAYOUT[sig])
+													  : std::to_string(sig * signal_size) + "|" + std::to_string(signal_size) + "@1+";
+			dbc += " SG_ " + name + " : " + layout + " (0.1,0) [0|100] \"km/h\" ECU2,ECU3\n";
+
+			if (options.value_descriptions > 0) {
+				value_lines += "VAL_ " + id + " " + name;
+				for (std::size_t value = 0; value < options.value_descriptions; value++) {
+					value_lines += " " + std::to_string(value) + " \"State " + std::to_string(value) + "\"";
+				}
+				value_lines += " ;\n";
+			}
+		}
+
+		if (options.cycle_time_ms > 0) {
+			attribute_lines += "BA_ \"GenMsgCycleTime\" BO_ " + id + " " + std::to_string(options.cycle_time_ms) + ";\n";
+		}
+
+		if (options.multiplexed_signals > 0) {
+			dbc += " SG_ MUX_" + id + " M : 0|8@1+ (1,0) [0|255] \"\" ECU2\n";
+			for (std::size_t sig = 0; sig < options.multiplexed_signals; sig++) {
+				dbc += " SG_ MUXED_" + id + "_" + std::to_string(sig) + " m" + std::to_string(sig) + " : 8|16@1+ (1,0) [0|65535] \"\" ECU2\n";
+			}
+		}
+		dbc += "\n";
+	}
+
+	if (options.cycle_time_ms > 0) {
+		dbc += "BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 65535;\n";
+	}
+	return dbc + attribute_lines + value_lines;
+}
+
+std::vector<Frame> generate_frames(const DbcOptions& options, std::size_t count, uint32_t seed) {
+	std::mt19937 engine(seed);
+	std::uniform_int_distribution<std::size_t> message(0, options.messages == 0 ? 0 : options.messages - 1);
+	std::uniform_int_distribution<int> byte(0, 255);
+
+	std::vector<Frame> frames(count);
+	for (auto& frame : frames) {
+		frame.id = message_id(message(engine));
+		frame.data.resize(payload_size(options));
+		for (auto& value : frame.data) {
+			value = static_cast<uint8_t>(byte(engine));
+		}
+	}
+	return frames;
+}
+
+}
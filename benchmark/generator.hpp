@@ -0,0 +1,43 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Bench {
+
+struct DbcOptions {
+	std::size_t messages = 100;
+	std::size_t signals_per_message = 8;
+	// Entries in the VAL_ line written for every signal, 0 writes none
+	std::size_t value_descriptions = 0;
+	// Signals per message selected by an extra multiplexer signal, 0 disables multiplexing
+	std::size_t multiplexed_signals = 0;
+	// 64 byte payloads instead of 8
+	bool can_fd = false;
+	// GenMsgCycleTime written for every message, 0 writes none
+	uint32_t cycle_time_ms = 0;
+	// Replaces the evenly sized signals with a fixed realistic mix of byte aligned Intel and
+	// Motorola fields and odd bit fields. Ignores signals_per_message and can_fd.
+	bool mixed_layouts = false;
+};
+
+struct Frame {
+	uint32_t id;
+	std::vector<uint8_t> data;
+};
+
+// Builds the text of a syntactically valid DBC file with the requested shape.
+std::string generate_dbc(const DbcOptions& options);
+
+// Random traffic for a database built from the same options. Ids are drawn uniformly from its messages.
+std::vector<Frame> generate_frames(const DbcOptions& options, std::size_t count, uint32_t seed = 1);
+
+// Id of the n-th message written by generate_dbc
+uint32_t message_id(std::size_t index);
+
+}
+
+#endif // GENERATOR_HPP
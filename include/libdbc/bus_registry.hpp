@@ -0,0 +1,75 @@
+#ifndef BUS_REGISTRY_HPP
+#define BUS_REGISTRY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/message.hpp>
+#include <libdbc/parse_result.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Libdbc {
+
+/**
+ * Databases for several CAN channels, each channel with its own DBC file. Channels whose files
+ * have identical contents share one parsed database, and all channels end up in one
+ * (channel, id) index so decoding a frame from any channel is a single lookup.
+ *
+ * Register the channels with add_channel() and call load() once, the distinct files are then
+ * parsed in parallel. After loading the registry is read only and decode() can be called from
+ * any number of threads. It decodes with the plans only, observers and metrics of the
+ * underlying parsers are not involved.
+ */
+class BusRegistry {
+public:
+	struct Entry {
+		uint32_t channel;
+		const DbcParser* database;
+		const Message* message;
+		const DecodePlan* plan;
+	};
+
+	// Registering a channel again replaces its file. Takes effect on the next load().
+	void add_channel(uint32_t channel, const std::string& file_name);
+
+	/**
+	 * Parses the registered files with up to max_threads threads, 0 uses one per hardware thread.
+	 * Returns false when any channel failed, see channel_result(). Failed channels have no entries.
+	 */
+	bool load(unsigned max_threads = 0);
+
+	// nullptr for channels that weren't registered
+	const ParseResult* channel_result(uint32_t channel) const;
+	const DbcParser* database(uint32_t channel) const;
+
+	std::size_t channel_count() const;
+	// Number of distinct databases after load(), at most channel_count()
+	std::size_t database_count() const;
+
+	const Entry* find(uint32_t channel, uint32_t message_id) const;
+	Message::ParseSignalsStatus decode(uint32_t channel, uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values) const;
+
+private:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	struct Channel {
+		std::string file_name;
+		std::size_t database;
+		ParseResult result;
+	};
+
+	static uint64_t key(uint32_t channel, uint32_t message_id);
+
+	std::map<uint32_t, Channel> m_channels;
+	std::vector<std::unique_ptr<DbcParser>> m_databases;
+	std::unordered_map<uint64_t, Entry> m_index;
+};
+
+}
+
+#endif // BUS_REGISTRY_HPP
@@ -0,0 +1,124 @@
+#ifndef DATABASE_IMAGE_HPP
+#define DATABASE_IMAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/message.hpp>
+#include <string>
+#include <vector>
+
+namespace Libdbc {
+
+/**
+ * Flat, pointer free copy of a parsed database that can be decoded against in place. Everything
+ * inside is addressed by offsets, so the image works wherever it is mapped, e.g. in POSIX shared
+ * memory or a file several decoder processes map read only.
+ *
+ * Images hold the decode plans as they are laid out in memory, so they are only valid for the
+ * same library build on the same host. DatabaseView rejects anything else.
+ */
+class DatabaseImage {
+public:
+	/**
+	 * Messages are sorted by id, a repeated id keeps its first definition like the parser does.
+	 * Views only decode classic 8 byte frames, messages with signals past that are left out.
+	 */
+	static std::vector<uint8_t> build(const DbcParser& parser, uint64_t generation);
+
+	/**
+	 * Writes the image next to path and renames it over path. Readers that already mapped the
+	 * old image keep it until they refresh, new readers only ever see a complete image.
+	 */
+	static bool publish(const DbcParser& parser, uint64_t generation, const std::string& path);
+};
+
+/**
+ * Read only access to an image. The view doesn't own the memory, which must stay mapped and
+ * unchanged while it is attached.
+ */
+class DatabaseView {
+public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	// Checks the header, that every table and string lies inside size bytes and every plan inside 8 bytes. data must be 8 byte aligned.
+	bool attach(const void* data, std::size_t size);
+	void detach();
+	bool is_attached() const;
+
+	uint64_t generation() const;
+	std::size_t message_count() const;
+
+	// Index of the message with this id, npos when there is none
+	std::size_t find_message(uint32_t message_id) const;
+	uint32_t message_id(std::size_t message) const;
+	const char* message_name(std::size_t message) const;
+	uint8_t message_size(std::size_t message) const;
+	uint32_t cycle_time(std::size_t message) const;
+
+	std::size_t signal_count(std::size_t message) const;
+	const SignalPlan* signals(std::size_t message) const;
+	const char* signal_name(std::size_t message, std::size_t signal) const;
+	const char* signal_unit(std::size_t message, std::size_t signal) const;
+
+	// Same results as DbcParser::parse_message
+	Message::ParseSignalsStatus decode(uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values) const;
+	// values must have room for signal_count() entries of the message
+	Message::ParseSignalsStatus decode(uint32_t message_id, const uint8_t* data, std::size_t size, double* values) const;
+
+private:
+	friend class DatabaseImage;
+
+	struct ImageMessage;
+	struct ImageSignal;
+
+	const ImageMessage& message_at(std::size_t message) const;
+	const char* string_at(uint32_t offset) const;
+
+	const uint8_t* m_data = nullptr;
+	uint64_t m_generation = 0;
+	std::size_t m_message_count = 0;
+	const ImageMessage* m_messages = nullptr;
+	const SignalPlan* m_plans = nullptr;
+	const ImageSignal* m_signals = nullptr;
+	const char* m_strings = nullptr;
+};
+
+/**
+ * An image file mapped read only. On Linux POSIX shared memory objects are files under
+ * /dev/shm, so publishing there and opening the same path shares one copy between processes.
+ * Only available on POSIX systems, open fails elsewhere.
+ */
+class MappedImage {
+public:
+	MappedImage() = default;
+	~MappedImage();
+
+	MappedImage(const MappedImage&) = delete;
+	MappedImage& operator=(const MappedImage&) = delete;
+
+	bool open(const std::string& path);
+	void close();
+
+	/**
+	 * Maps the file at the opened path again when it now holds a newer generation, e.g. after a
+	 * DatabaseImage::publish. Returns true when the view changed, the old mapping is released.
+	 */
+	bool refresh();
+
+	const DatabaseView& view() const;
+
+private:
+	bool map(const std::string& path, uint64_t min_generation);
+	void unmap();
+
+	std::string m_path;
+	void* m_address = nullptr;
+	std::size_t m_size = 0;
+	DatabaseView m_view;
+};
+
+}
+
+#endif // DATABASE_IMAGE_HPP
@@ -1,15 +1,54 @@
 #ifndef DBC_HPP
 #define DBC_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <istream>
+#include <libdbc/decode_observer.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/fixed_point.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/memory_resource.hpp>
 #include <libdbc/message.hpp>
+#include <libdbc/metadata.hpp>
+#include <libdbc/parse_report.hpp>
+#include <libdbc/parse_result.hpp>
+#include <libdbc/string_pool.hpp>
 #include <regex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Libdbc {
 
+/**
+ * Position of a signal inside a parsed database. Handles stay valid until the next parse_file call.
+ */
+struct SignalHandle {
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	SignalHandle() = default;
+	SignalHandle(std::size_t message_index, std::size_t signal_index);
+
+	std::size_t message_index = npos;
+	std::size_t signal_index = npos;
+
+	bool is_valid() const;
+	bool operator==(const SignalHandle& rhs) const;
+};
+
+// Comment and attribute lines are never unused, they go to metadata()
+enum class UnusedLines {
+	Keep, // the text of every line the parser didn't understand, see unused_lines()
+	Positions, // only where they were, see unused_line_positions()
+	Drop,
+};
+
+struct LinePosition {
+	std::size_t line; // 1 based like ParseResult::line
+	int64_t offset; // byte offset into the input, -1 when the stream can't tell
+};
+
 class Parser {
 public:
 	virtual ~Parser() = default;
@@ -23,22 +62,111 @@ protected:
 class DbcParser : public Parser {
 public:
 	DbcParser();
+	/**
+	 * Messages, signals and their receiver and value description lists, and the unused lines
+	 * are allocated from resource, which must outlive the parser. Names and the lookup indexes
+	 * stay on the global heap. With a MonotonicResource per loaded file a reload frees the old
+	 * database in one go, create a new parser and resource for it rather than calling parse_file again.
+	 */
+	explicit DbcParser(MemoryResource& resource);
 
 	void parse_file(const std::string& file_name) override;
 	void parse_file(std::istream& stream) override;
 
-	std::string get_version() const;
-	std::vector<std::string> get_nodes() const;
-	std::vector<Libdbc::Message> get_messages() const;
+	// Same parsing without exceptions, the error and where it happened are in the result.
+	ParseResult try_parse_file(const std::string& file_name);
+	ParseResult try_parse_file(std::istream& stream);
 
-	Message::ParseSignalsStatus parse_message(uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values);
+	const std::string& get_version() const;
+	const std::vector<std::string>& get_nodes() const;
+	const Vector<Message>& get_messages() const;
 
-	std::vector<std::string> unused_lines() const;
+	const Message* find_message(uint32_t message_id) const;
+	const Message* find_message(const std::string& name) const;
+
+	// Signals are addressed by their qualified name, "Message.Signal".
+	SignalHandle find_signal_handle(const std::string& qualified_name) const;
+	const Signal* find_signal(const std::string& qualified_name) const;
+	const Signal& get_signal(const SignalHandle& handle) const;
+
+	// Glob search with '*' and '?' over message names or qualified signal names. Results are in file order.
+	std::vector<const Message*> search_messages(const std::string& pattern) const;
+	std::vector<SignalHandle> search_signals(const std::string& pattern) const;
+
+	Message::ParseSignalsStatus parse_message(uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values);
+	// Same as above with the capture time handed to the observers. The overload without it uses the steady clock.
+	Message::ParseSignalsStatus parse_message(uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values, uint64_t timestamp_ns);
+
+	/**
+	 * Decodes a batch of frames with mixed ids. The batch is counting sorted by message first so
+	 * each message's plan is used for all of its frames in one go. Observers see the frames in
+	 * that grouped order, which keeps the order of frames within one message.
+	 */
+	void parse_batch(const Frame* frames, std::size_t count, BatchResult& result, BatchOrder order = BatchOrder::Original);
+	void parse_batch(const std::vector<Frame>& frames, BatchResult& result, BatchOrder order = BatchOrder::Original);
+
+	/**
+	 * Off by default. When enabled parse_batch also checks every decoded value against its
+	 * signal's [min|max], sets its bit in BatchResult::out_of_range and counts it per signal.
+	 * Signals without a range, min not below max, are never flagged.
+	 */
+	void enable_range_check(bool enable = true);
+	// Values out of range seen by parse_batch since the last parse_file or reset
+	uint64_t range_violations(const SignalHandle& handle) const;
+	void reset_range_violations();
+
+	// One plan per message covering all of its signals, in the order of get_messages().
+	const std::vector<DecodePlan>& get_decode_plans() const;
+
+	/**
+	 * Off by default. When enabled before parse_file the parser also converts every factor and
+	 * offset to integers, see FixedPointScale, and parse_message_fixed becomes available. It uses
+	 * integer arithmetic only and doesn't notify observers or record metrics.
+	 */
+	void enable_fixed_point(bool enable = true);
+	const std::vector<FixedPointPlan>& get_fixed_point_plans() const;
+	// Signals whose fixed point values are approximations
+	std::vector<SignalHandle> inexact_fixed_point_signals() const;
+	// Signals no integer scale fits, parse_message_fixed skips them and writes 0
+	std::vector<SignalHandle> unsupported_fixed_point_signals() const;
+	Message::ParseSignalsStatus parse_message_fixed(uint32_t message_id, const std::vector<uint8_t>& data, std::vector<int64_t>& out_values) const;
+
+	// Observers are not owned and must outlive the parser or be removed first.
+	void add_observer(DecodeObserver& observer);
+	void remove_observer(DecodeObserver& observer);
+
+	// Keep by default. Set before parse_file, the unmatched lines of large files can take as much memory as the rest.
+	void set_unused_lines(UnusedLines policy);
+	const Vector<std::string>& unused_lines() const;
+	const std::vector<LinePosition>& unused_line_positions() const;
+
+	// Comments and attributes, only split into lookup tables on first use
+	const Metadata& metadata() const;
+
+	// Off by default. When enabled every parse_file call fills in the report returned by get_parse_report().
+	void enable_parse_report(bool enable = true);
+	const ParseReport& get_parse_report() const;
 
 private:
 	std::string version;
 	std::vector<std::string> nodes;
-	std::vector<Libdbc::Message> messages;
+	MemoryResource* memory_resource;
+	Vector<Message> messages;
+	std::vector<DecodePlan> decode_plans;
+	bool build_fixed_point = false;
+	std::vector<FixedPointPlan> fixed_point_plans;
+	bool check_ranges = false;
+	std::vector<std::vector<uint64_t>> range_violation_counts;
+	StringPool string_pool;
+
+	std::unordered_map<uint32_t, std::size_t> message_id_index;
+	std::unordered_map<std::string, std::size_t> message_name_index;
+	std::unordered_map<std::string, SignalHandle> signal_name_index;
+
+	std::vector<DecodeObserver*> observers;
+
+	bool collect_report = false;
+	ParseReport report;
 
 	std::regex version_re;
 	std::regex bit_timing_re;
@@ -47,14 +175,28 @@ private:
 	std::regex message_re;
 	std::regex value_re;
 	std::regex signal_re;
-
-	std::vector<std::string> missed_lines;
-
-	void parse_dbc_header(std::istream& file_stream);
-	void parse_dbc_nodes(std::istream& file_stream);
-	void parse_dbc_messages(const std::vector<std::string>& lines);
+	std::regex cycle_time_re;
+	std::regex cycle_time_default_re;
+
+	UnusedLines unused_lines_policy = UnusedLines::Keep;
+	Vector<std::string> missed_lines;
+	std::vector<LinePosition> missed_line_positions;
+	std::size_t missed_line_count = 0;
+	Metadata database_metadata;
+
+	ParseResult parse_stream(std::istream& stream);
+	ParseResult parse_dbc_header(std::istream& file_stream, std::size_t& line_number);
+	void parse_dbc_nodes(std::istream& file_stream, std::size_t& line_number);
+	void parse_dbc_messages(const std::vector<std::string>& lines, const std::vector<LinePosition>& positions);
+	void add_unused_line(const std::string& line, const LinePosition& position, std::vector<std::string>& kept_lines);
+	void build_indexes();
+	void flag_out_of_range(const DecodePlan& plan, std::size_t message_index, const double* values, std::size_t first_value, std::vector<uint64_t>& flags);
+	void account_memory();
+
+	InternedString intern_group(const std::smatch& match, unsigned group);
 
 	static std::string get_extension(const std::string& file_name);
+	static void throw_on_error(const ParseResult& result);
 };
 
 }
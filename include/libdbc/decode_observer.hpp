@@ -0,0 +1,34 @@
+#ifndef DECODE_OBSERVER_HPP
+#define DECODE_OBSERVER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Libdbc {
+
+struct Message;
+
+// One successfully decoded frame. values holds one entry per signal of message, in signal order.
+struct DecodedMessage {
+	const Message* message;
+	std::size_t message_index;
+	const double* values;
+	std::size_t value_count;
+	uint64_t timestamp_ns;
+};
+
+/**
+ * Hook into DbcParser::parse_message. Observers are called on the decoding thread right after
+ * a frame decodes successfully, so they should return quickly. They are not called for
+ * frames that fail to decode.
+ */
+class DecodeObserver {
+public:
+	virtual ~DecodeObserver() = default;
+
+	virtual void on_decoded(const DecodedMessage& decoded) = 0;
+};
+
+}
+
+#endif // DECODE_OBSERVER_HPP
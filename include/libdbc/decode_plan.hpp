@@ -0,0 +1,131 @@
+#ifndef DECODE_PLAN_HPP
+#define DECODE_PLAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/message.hpp>
+#include <libdbc/signal.hpp>
+#include <vector>
+
+namespace Libdbc {
+
+// A classic CAN payload loaded once into both byte orders.
+struct PayloadWords {
+	uint64_t little_endian;
+	uint64_t big_endian;
+	std::size_t length_bits;
+
+	static PayloadWords load(const uint8_t* data, std::size_t size);
+};
+
+// A payload whose words are only built once a signal needs the generic bit path.
+class Payload {
+public:
+	Payload(const uint8_t* data, std::size_t size);
+
+	const uint8_t* data() const;
+	std::size_t size() const;
+	const PayloadWords& words();
+
+private:
+	const uint8_t* m_data;
+	std::size_t m_size;
+	bool m_loaded;
+	PayloadWords m_words;
+};
+
+/**
+ * The parts of a Signal needed to decode it, copied out so a plan stays small and
+ * contiguous. signal_index points back at the signal inside its Message.
+ */
+struct SignalPlan {
+	// Byte aligned 8, 16 and 32 bit fields are read straight from the payload
+	enum class Layout : uint8_t {
+		Generic,
+		Byte,
+		LittleEndian16,
+		LittleEndian32,
+		BigEndian16,
+		BigEndian32,
+	};
+
+	SignalPlan(const Signal& signal, std::size_t signal_index);
+
+	std::size_t signal_index;
+	Layout layout;
+	uint32_t first_byte; // only used by the aligned layouts
+	uint32_t byte_count;
+	uint32_t start_bit;
+	uint32_t size;
+	bool is_bigendian;
+	bool is_signed;
+	double factor;
+	double offset;
+	// Plausibility limits from the signal's [min|max], infinite when the file gives no range
+	double min;
+	double max;
+
+	uint64_t raw(const PayloadWords& words) const;
+	// The raw bits masked to size and sign extended when the signal is signed, integer arithmetic only
+	int64_t integer(uint64_t raw_value) const;
+	double physical(uint64_t raw_value) const;
+	// Only valid for the aligned layouts when the payload covers first_byte + byte_count
+	double decode_aligned(const uint8_t* data) const;
+	double decode(const PayloadWords& words) const;
+	double decode(Payload& payload) const;
+
+	// Reads the raw bits straight from a payload of any length, missing bytes read as zero
+	uint64_t extract(const uint8_t* data, std::size_t data_size) const;
+
+	// Payload bytes the signal reaches into
+	std::size_t end_byte() const;
+	// Physical value to raw bits, rounded and clamped to the range the signal can hold
+	uint64_t raw_from_physical(double value) const;
+	// Writes the low size bits of raw_value and leaves the rest of the payload alone. data must cover end_byte().
+	void insert(uint64_t raw_value, uint8_t* data) const;
+	void encode(double value, uint8_t* data) const;
+};
+
+// One signal decoded straight from the Signal, for callers without a plan. Same value as SignalPlan::decode.
+double decode_signal(const Signal& signal, const PayloadWords& words);
+
+/**
+ * Precompiled decoder for one message. It can cover all of the message's signals or only a
+ * subset of them, values come out in the order of signals().
+ */
+class DecodePlan {
+public:
+	explicit DecodePlan(const Message& message);
+	DecodePlan(const Message& message, const std::vector<std::size_t>& signal_indices);
+
+	uint32_t id() const;
+	const std::vector<SignalPlan>& signals() const;
+
+	Message::ParseSignalsStatus decode(const std::vector<uint8_t>& data, std::vector<double>& values) const;
+	// values must have room for signals().size() entries
+	Message::ParseSignalsStatus decode(const uint8_t* data, std::size_t size, double* values) const;
+	// Same without the 8 byte limit, e.g. for payloads reassembled by a TransportReassembler
+	void decode_extended(const uint8_t* data, std::size_t size, double* values) const;
+
+	/**
+	 * Checks count values, at most 64, against the limits of signals()[first] onwards. Bit i of
+	 * the result is set when values[i] is below min or above max. Branch free so it costs about
+	 * the same whether or not anything is out of range.
+	 */
+	uint64_t out_of_range(const double* values, std::size_t first, std::size_t count) const;
+
+private:
+	void classify_signals();
+
+	uint32_t m_id;
+	std::vector<SignalPlan> m_signals;
+	std::size_t m_aligned_size; // payload bytes needed to read every aligned signal directly
+	bool m_has_generic;
+	// The limits again as flat arrays so the range check loads them straight into vector registers
+	std::vector<double> m_min;
+	std::vector<double> m_max;
+};
+
+}
+
+#endif // DECODE_PLAN_HPP
@@ -0,0 +1,121 @@
+#ifndef DOWNSAMPLER_HPP
+#define DOWNSAMPLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_observer.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Libdbc {
+
+enum class DownsampleMode {
+	Summary, // first, last, min, max and mean of every bucket
+	Lttb, // the summary plus one representative sample picked by largest triangle three buckets
+};
+
+struct DownsampleConfig {
+	uint64_t bucket_ns = 100000000;
+	DownsampleMode mode = DownsampleMode::Summary;
+	// Lttb only: samples of a bucket kept as candidates, beyond that every other one is dropped
+	std::size_t max_points = 256;
+};
+
+struct DownsampledBucket {
+	SignalHandle signal;
+	uint64_t start_ns;
+	uint64_t count;
+	double first;
+	double last;
+	double min;
+	double max;
+	double mean;
+	// The representative sample, the last one in Summary mode
+	uint64_t point_ns;
+	double point_value;
+};
+
+/**
+ * Keeps per bucket summaries of selected signals instead of every sample. Attach it to a
+ * DbcParser with add_observer(); only signals added with add_signal() are looked at.
+ *
+ * A bucket is emitted once a sample of a later bucket arrives, or by flush(). In Lttb mode a
+ * bucket's sample can only be picked once the next bucket is complete, so it is emitted one
+ * bucket later. Empty buckets are skipped. Memory per signal is fixed when it is added, the
+ * callback fires on the decoding thread after the internal lock was released.
+ */
+class Downsampler : public DecodeObserver {
+public:
+	using Callback = std::function<void(const DownsampledBucket&)>;
+
+	Downsampler(const DbcParser& parser, Callback callback);
+
+	// Signals are addressed by their qualified name, "Message.Signal". Adding one again replaces its config.
+	bool add_signal(const std::string& qualified_name, const DownsampleConfig& config = DownsampleConfig());
+	bool add_signal(const SignalHandle& handle, const DownsampleConfig& config = DownsampleConfig());
+	// Every signal matching the glob pattern, see DbcParser::search_signals. Returns the number added.
+	std::size_t add_signals(const std::string& pattern, const DownsampleConfig& config = DownsampleConfig());
+
+	void on_decoded(const DecodedMessage& decoded) override;
+
+	// Emits the buckets still open, e.g. at the end of a log
+	void flush();
+
+	std::size_t signal_count() const;
+
+private:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	struct Point {
+		uint64_t timestamp_ns;
+		double value;
+	};
+
+	struct Accumulator {
+		bool open;
+		uint64_t index; // timestamp / bucket_ns
+		uint64_t count;
+		double first;
+		double last;
+		double min;
+		double max;
+		double sum;
+		double time_sum; // ns after the bucket start, for the mean time Lttb needs
+		uint64_t last_ns;
+	};
+
+	struct Track {
+		SignalHandle handle;
+		DownsampleConfig config;
+		Accumulator current;
+		std::vector<Point> candidates;
+		std::size_t stride; // only every stride-th sample becomes a candidate
+		std::size_t skipped;
+		// Lttb: the previous bucket waits here until the current one is complete
+		Accumulator pending;
+		std::vector<Point> pending_candidates;
+		bool has_selected;
+		Point selected;
+	};
+
+	void add(Track& track, uint64_t timestamp_ns, double value);
+	void close_current(Track& track);
+	void emit_pending(Track& track, const Accumulator* next);
+	DownsampledBucket summary(const Track& track, const Accumulator& acc) const;
+
+	const DbcParser& m_parser;
+	Callback m_callback;
+
+	mutable std::mutex m_mutex;
+	std::vector<std::size_t> m_message_offsets;
+	std::vector<std::size_t> m_track_by_signal; // npos for signals that aren't downsampled
+	std::vector<Track> m_tracks;
+	std::vector<DownsampledBucket> m_ready;
+};
+
+}
+
+#endif // DOWNSAMPLER_HPP
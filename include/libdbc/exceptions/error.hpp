@@ -1,9 +1,18 @@
 #ifndef ERROR_HPP
 #define ERROR_HPP
 
+#include <cstdlib>
 #include <exception>
 #include <string>
 
+// The decode path never throws. Builds with exceptions disabled abort where the throwing parse
+// API would throw, use DbcParser::try_parse_file there instead.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define DBC_THROW(exception) throw exception
+#else
+#define DBC_THROW(exception) std::abort()
+#endif
+
 namespace Libdbc {
 
 class Exception : public std::exception {
@@ -0,0 +1,64 @@
+#ifndef FIXED_POINT_HPP
+#define FIXED_POINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/message.hpp>
+#include <vector>
+
+namespace Libdbc {
+
+/**
+ * Integer form of a signal's factor and offset: physical = (raw * multiplier + addend) / denominator.
+ *
+ * The denominator is the smallest power of ten or power of two that represents both the factor
+ * and the offset exactly. When there is none, or the scaled value could overflow 64 bits, the
+ * signal gets the closest Q-format approximation that fits and exact is false. A factor of 1
+ * with no offset is always exact, the value is the raw integer. An unsigned 64 bit one above
+ * INT64_MAX comes out as its bit pattern, cast it back to uint64_t.
+ *
+ * Signals no scale fits without overflowing, e.g. wide signals with small factors, have
+ * fixed_point set to false. They can't be decoded in integers and are skipped.
+ */
+struct FixedPointScale {
+	int64_t multiplier;
+	int64_t addend;
+	int64_t denominator;
+	bool exact;
+	bool fixed_point;
+
+	static FixedPointScale from_signal(const Signal& signal);
+};
+
+/**
+ * Decoder for targets without a double precision FPU. Values come out as scaled integers, one
+ * per signal in message order, using integer arithmetic only. Divide by the signal's denominator
+ * to get the physical value.
+ */
+class FixedPointPlan {
+public:
+	explicit FixedPointPlan(const Message& message);
+
+	uint32_t id() const;
+	const std::vector<SignalPlan>& signals() const;
+	const std::vector<FixedPointScale>& scales() const;
+
+	// Indices of the signals whose scaled values are approximations.
+	std::vector<std::size_t> inexact_signals() const;
+	// Indices of the signals without a fixed point scale, decode writes 0 for them.
+	std::vector<std::size_t> unsupported_signals() const;
+
+	// values must have room for signals().size() entries
+	Message::ParseSignalsStatus decode(const uint8_t* data, std::size_t size, int64_t* values) const;
+	Message::ParseSignalsStatus decode(const std::vector<uint8_t>& data, std::vector<int64_t>& values) const;
+
+private:
+	uint32_t m_id;
+	std::vector<SignalPlan> m_signals;
+	std::vector<FixedPointScale> m_scales;
+};
+
+}
+
+#endif // FIXED_POINT_HPP
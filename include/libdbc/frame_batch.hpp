@@ -0,0 +1,53 @@
+#ifndef FRAME_BATCH_HPP
+#define FRAME_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/message.hpp>
+#include <vector>
+
+namespace Libdbc {
+
+// A received frame. The payload is not owned and only needs to live for the call it is passed to.
+struct Frame {
+	uint32_t id;
+	const uint8_t* data;
+	std::size_t size;
+	uint64_t timestamp_ns;
+};
+
+enum class BatchOrder {
+	Original, // BatchResult::frames follows the input
+	Grouped, // BatchResult::frames is sorted by message, keeping the input order inside a message
+};
+
+struct DecodedFrame {
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	std::size_t frame_index; // position in the input batch
+	std::size_t message_index; // npos for unknown ids
+	Message::ParseSignalsStatus status;
+	std::size_t first_value; // into BatchResult::values
+	std::size_t value_count; // 0 unless status is Success
+};
+
+/**
+ * Output of DbcParser::parse_batch. Reuse one result across batches, its vectors keep their capacity.
+ */
+struct BatchResult {
+	std::vector<DecodedFrame> frames;
+	std::vector<double> values;
+
+	// Input indices in message order. Frames of message m are at
+	// permutation[group_offsets[m]] up to permutation[group_offsets[m + 1]], unknown ids come last.
+	std::vector<std::size_t> permutation;
+	std::vector<std::size_t> group_offsets;
+
+	// Only filled while DbcParser::enable_range_check is on. Bit i % 64 of word i / 64 is set
+	// when values[i] lies outside its signal's [min|max].
+	std::vector<uint64_t> out_of_range;
+};
+
+}
+
+#endif // FRAME_BATCH_HPP
@@ -0,0 +1,74 @@
+#ifndef GATEWAY_HPP
+#define GATEWAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Libdbc {
+
+/**
+ * Copies signals from the messages of one database into the messages of another, e.g. between
+ * two buses. Every route is compiled into a move between two SignalPlans when it is added. Routes
+ * whose signals share factor, offset and signedness and whose destination is at least as wide
+ * move the raw bits, the others are decoded and encoded again.
+ *
+ * Destination payloads live in the gateway and keep the last value of every routed signal, bits
+ * that no route writes stay zero. A frame costs one lookup plus its moves and never allocates
+ * once `out` has grown. The gateway is not thread safe.
+ */
+class Gateway {
+public:
+	// Both databases must outlive the gateway.
+	Gateway(const DbcParser& source, const DbcParser& destination);
+
+	// Signals are addressed by their qualified name, "Message.Signal". Returns false when either doesn't exist.
+	bool add_route(const std::string& source_signal, const std::string& destination_signal);
+
+	/**
+	 * Applies the routes of the frame's message and appends one frame per destination message it
+	 * feeds. Their data points into the gateway and stays valid until the next call. Returns the
+	 * number of frames appended, 0 for frames without routes or longer than 8 bytes.
+	 */
+	std::size_t route(const Frame& frame, std::vector<Frame>& out);
+
+	std::size_t route_count() const;
+	// Routes that move raw bits without converting to the physical value
+	std::size_t direct_route_count() const;
+
+private:
+	struct Move {
+		SignalPlan from;
+		SignalPlan to;
+		std::size_t destination;
+		bool direct;
+	};
+
+	struct Source {
+		std::vector<Move> moves;
+		std::vector<std::size_t> destinations; // each fed destination once, in the order of the first route
+	};
+
+	struct Destination {
+		uint32_t id;
+		std::vector<uint8_t> payload;
+	};
+
+	const DbcParser& m_source;
+	const DbcParser& m_destination;
+
+	std::unordered_map<uint32_t, Source> m_sources;
+	std::unordered_map<uint32_t, std::size_t> m_destination_index;
+	std::vector<Destination> m_destinations;
+	std::size_t m_routes;
+	std::size_t m_direct_routes;
+};
+
+}
+
+#endif // GATEWAY_HPP
@@ -0,0 +1,31 @@
+#ifndef ID_FILTER_HPP
+#define ID_FILTER_HPP
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace Libdbc {
+
+/**
+ * Fixed size bitmap over message ids. Standard 11 bit ids map to their own bit so the answer
+ * for them is exact, extended ids are folded in and may give false positives but never
+ * false negatives. Use it to drop unknown frames before a hash lookup.
+ */
+class IdFilter {
+public:
+	static constexpr std::size_t BITS = 4096;
+
+	void insert(uint32_t message_id);
+	bool may_contain(uint32_t message_id) const;
+	void clear();
+
+private:
+	static std::size_t bit_for(uint32_t message_id);
+
+	std::bitset<BITS> m_bits;
+};
+
+}
+
+#endif // ID_FILTER_HPP
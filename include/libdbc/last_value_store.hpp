@@ -0,0 +1,61 @@
+#ifndef LAST_VALUE_STORE_HPP
+#define LAST_VALUE_STORE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_observer.hpp>
+#include <memory>
+#include <vector>
+
+namespace Libdbc {
+
+/**
+ * Latest decoded value and timestamp of every signal in a database.
+ *
+ * Attach it to a DbcParser with add_observer(). Each message is guarded by a sequence lock:
+ * the decoding thread never waits for readers, readers retry when they raced a write. A
+ * sample's value and timestamp always come from the same frame.
+ */
+class LastValueStore : public DecodeObserver {
+public:
+	struct Sample {
+		double value;
+		uint64_t timestamp_ns;
+		bool valid; // false until the message was decoded once
+	};
+
+	explicit LastValueStore(const DbcParser& parser);
+
+	void on_decoded(const DecodedMessage& decoded) override;
+
+	Sample read(const SignalHandle& handle) const;
+	// Fills samples with one entry per handle. Reuse the vector to avoid allocating.
+	void snapshot(const std::vector<SignalHandle>& handles, std::vector<Sample>& samples) const;
+
+	// Number of times a reader had to retry because a write was in progress.
+	uint64_t read_retries() const;
+
+private:
+	// Padded so two messages written back to back don't share a cache line
+	struct MessageSlot {
+		std::atomic<uint64_t> timestamp_ns;
+		std::size_t first_value;
+		std::size_t value_count;
+		std::atomic<uint32_t> sequence;
+		char padding[64 - sizeof(std::atomic<uint64_t>) - 2 * sizeof(std::size_t) - sizeof(std::atomic<uint32_t>)];
+	};
+
+	uint32_t begin_read(const MessageSlot& slot) const;
+	bool end_read(const MessageSlot& slot, uint32_t sequence) const;
+
+	std::size_t m_message_count;
+	std::unique_ptr<MessageSlot[]> m_slots;
+	std::unique_ptr<std::atomic<uint64_t>[]> m_values;
+	mutable std::atomic<uint64_t> m_read_retries;
+};
+
+}
+
+#endif // LAST_VALUE_STORE_HPP
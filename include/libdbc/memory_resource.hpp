@@ -0,0 +1,121 @@
+#ifndef MEMORY_RESOURCE_HPP
+#define MEMORY_RESOURCE_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace Libdbc {
+
+/**
+ * Where a parsed database gets its memory from, a C++11 stand in for std::pmr::memory_resource.
+ * Resources are not owned by the containers using them and must outlive them.
+ */
+class MemoryResource {
+public:
+	virtual ~MemoryResource() = default;
+
+	virtual void* allocate(std::size_t bytes, std::size_t alignment) = 0;
+	virtual void deallocate(void* pointer, std::size_t bytes, std::size_t alignment) = 0;
+};
+
+// Global operator new and delete, used whenever no resource is given
+MemoryResource& default_resource();
+
+/**
+ * Arena that only ever grows. deallocate does nothing, everything is handed back at once by
+ * release() or the destructor, so a database built on it doesn't fragment the heap and is freed
+ * in one shot.
+ *
+ * It can start from a caller owned buffer, e.g. preallocated or shared memory, and only takes
+ * chunks from upstream once that is used up. Not thread safe.
+ */
+class MonotonicResource : public MemoryResource {
+public:
+	explicit MonotonicResource(std::size_t chunk_size = 4096, MemoryResource& upstream = default_resource());
+	MonotonicResource(void* buffer, std::size_t size, MemoryResource& upstream = default_resource());
+	~MonotonicResource() override;
+
+	MonotonicResource(const MonotonicResource&) = delete;
+	MonotonicResource& operator=(const MonotonicResource&) = delete;
+
+	void* allocate(std::size_t bytes, std::size_t alignment) override;
+	void deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+
+	// Frees every chunk taken from upstream and starts over at the beginning of the initial buffer
+	void release();
+	// Bytes handed out since construction or the last release, padding included
+	std::size_t bytes_allocated() const;
+	std::size_t upstream_chunks() const;
+
+private:
+	struct Chunk {
+		Chunk* next;
+		std::size_t size;
+	};
+
+	MemoryResource& m_upstream;
+	char* m_buffer;
+	std::size_t m_buffer_size;
+	std::size_t m_chunk_size;
+	Chunk* m_chunks;
+	std::size_t m_chunk_count;
+	char* m_current;
+	std::size_t m_available;
+	std::size_t m_allocated;
+};
+
+/**
+ * Standard allocator handing out memory from a MemoryResource. Copies and rebinds share the
+ * resource, a default constructed allocator uses default_resource().
+ */
+template <typename T>
+class Allocator {
+public:
+	using value_type = T;
+
+	Allocator()
+		: m_resource(&default_resource()) {
+	}
+
+	Allocator(MemoryResource& resource)
+		: m_resource(&resource) {
+	}
+
+	template <typename U>
+	Allocator(const Allocator<U>& other)
+		: m_resource(other.resource()) {
+	}
+
+	T* allocate(std::size_t count) {
+		return static_cast<T*>(m_resource->allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* pointer, std::size_t count) {
+		m_resource->deallocate(pointer, count * sizeof(T), alignof(T));
+	}
+
+	MemoryResource* resource() const {
+		return m_resource;
+	}
+
+private:
+	MemoryResource* m_resource;
+};
+
+template <typename T, typename U>
+bool operator==(const Allocator<T>& lhs, const Allocator<U>& rhs) {
+	return lhs.resource() == rhs.resource();
+}
+
+template <typename T, typename U>
+bool operator!=(const Allocator<T>& lhs, const Allocator<U>& rhs) {
+	return !(lhs == rhs);
+}
+
+// The containers of a parsed database
+template <typename T>
+using Vector = std::vector<T, Allocator<T>>;
+
+}
+
+#endif // MEMORY_RESOURCE_HPP
@@ -1,9 +1,12 @@
 #ifndef MESSAGE_HPP
 #define MESSAGE_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <libdbc/memory_resource.hpp>
 #include <libdbc/signal.hpp>
+#include <libdbc/string_pool.hpp>
 #include <string>
 #include <vector>
 
@@ -11,7 +14,13 @@ namespace Libdbc {
 struct Message {
 	Message() = delete;
 	virtual ~Message() = default;
-	explicit Message(uint32_t message_id, const std::string& name, uint8_t size, const std::string& node);
+	explicit Message(uint32_t message_id, const std::string& name, uint8_t size, const InternedString& node, MemoryResource& resource = default_resource());
+	Message(const Message&) = default;
+	Message(Message&&) = default;
+	Message& operator=(const Message&) = default;
+	Message& operator=(Message&&) = default;
+	// Copy whose signals are allocated from resource, with no spare capacity
+	Message(const Message& other, MemoryResource& resource);
 
 	enum class ParseSignalsStatus {
 		Success,
@@ -24,11 +33,17 @@ struct Message {
 	ParseSignalsStatus parse_signals(const std::vector<uint8_t>& data, std::vector<double>& values) const;
 
 	void append_signal(const Signal& signal);
-	std::vector<Signal> get_signals() const;
+	const Vector<Signal>& get_signals() const;
+	const Signal* find_signal(const std::string& name) const;
 	uint32_t id() const;
 	uint8_t size() const;
 	const std::string& name() const;
+	const InternedString& node() const;
+	// Expected period in milliseconds from the GenMsgCycleTime attribute, 0 when the message is not periodic
+	uint32_t cycle_time() const;
+	void set_cycle_time(uint32_t cycle_time_ms);
 	void add_value_description(const std::string& signal_name, const std::vector<Signal::ValueDescription>&);
+	void add_value_description(std::size_t signal_index, const std::vector<Signal::ValueDescription>&);
 
 	virtual bool operator==(const Message& rhs) const;
 
@@ -36,8 +51,9 @@ private:
 	uint32_t m_id;
 	std::string m_name;
 	uint8_t m_size;
-	std::string m_node;
-	std::vector<Signal> m_signals;
+	InternedString m_node;
+	uint32_t m_cycle_time = 0;
+	Vector<Signal> m_signals;
 
 	friend std::ostream& operator<<(std::ostream& out, const Message& msg);
 };
@@ -0,0 +1,73 @@
+#ifndef METADATA_HPP
+#define METADATA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Libdbc {
+
+/**
+ * Comments (CM_) and attribute values (BA_, with BA_DEF_DEF_ defaults) of a parsed database.
+ * Parsing only keeps their text, the lookup tables are built on the first lookup and the text
+ * is released then. Processes that only decode never pay for splitting them up.
+ *
+ * Lookups are safe from several threads, the first one builds the tables under a lock.
+ */
+class Metadata {
+public:
+	Metadata() = default;
+	Metadata(const Metadata& other);
+	Metadata& operator=(const Metadata& other);
+
+	const std::string* database_comment() const;
+	const std::string* node_comment(const std::string& node) const;
+	const std::string* message_comment(uint32_t message_id) const;
+	const std::string* signal_comment(uint32_t message_id, const std::string& signal_name) const;
+
+	// Values as written in the file, strings without their quotes. Unset values fall back to the BA_DEF_DEF_ default.
+	const std::string* attribute(const std::string& name) const;
+	const std::string* node_attribute(const std::string& name, const std::string& node) const;
+	const std::string* message_attribute(const std::string& name, uint32_t message_id) const;
+	const std::string* signal_attribute(const std::string& name, uint32_t message_id, const std::string& signal_name) const;
+
+	bool is_indexed() const;
+	// Text waiting to be indexed plus the tables once built
+	std::size_t memory_bytes() const;
+
+private:
+	friend class DbcParser;
+
+	static bool is_metadata_line(const std::string& line);
+	// A line that starts a DBC statement never continues a string, whatever append() returned
+	static bool is_statement_start(const std::string& line);
+	/**
+	 * Returns true while a quoted string is still open, the next line then continues the statement.
+	 * DBC strings have no escapes, a backslash is kept as it is.
+	 */
+	bool append(const std::string& line);
+	// Closes a string a statement left open, so it doesn't run into the statements after it
+	void end_statement();
+	void clear();
+
+	void index() const;
+	const std::string* find(const std::unordered_map<std::string, std::string>& table, const std::string& key) const;
+	const std::string* find_attribute(const std::string& name, const std::string& object) const;
+
+	mutable std::string m_text;
+	bool m_in_string = false;
+
+	// Keyed by object, "" for the database, "BU_ node", "BO_ id" and "SG_ id signal". Attributes prefix the name and a newline.
+	mutable std::mutex m_index_mutex;
+	mutable std::atomic<bool> m_indexed{false};
+	mutable std::unordered_map<std::string, std::string> m_comments;
+	mutable std::unordered_map<std::string, std::string> m_attributes;
+	mutable std::unordered_map<std::string, std::string> m_defaults;
+};
+
+}
+
+#endif // METADATA_HPP
@@ -0,0 +1,65 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Opt-in decode instrumentation. Configure with DBC_ENABLE_METRICS to turn it on, otherwise
+ * the recording calls compile to nothing and snapshots come back empty with enabled == false.
+ *
+ * Every decoding thread counts into its own cache line padded block. Nothing is shared until
+ * snapshot() sums the blocks up, so it can be scraped from any thread at any time.
+ */
+#if defined(DBC_ENABLE_METRICS)
+#define DBC_METRICS_ONLY(...) __VA_ARGS__
+#else
+#define DBC_METRICS_ONLY(...)
+#endif
+
+namespace Libdbc {
+namespace Metrics {
+
+// Bucket i counts decodes that took [2^i, 2^(i+1)) nanoseconds, the last bucket holds everything slower.
+constexpr std::size_t LATENCY_BUCKETS = 32;
+
+struct MessageCount {
+	uint32_t message_id;
+	uint64_t frames;
+};
+
+struct MessageRate {
+	uint32_t message_id;
+	double frames_per_second;
+};
+
+struct Snapshot {
+	bool enabled;
+	uint64_t taken_at_ns;
+
+	uint64_t frames_decoded;
+	uint64_t unknown_id;
+	uint64_t message_too_long;
+
+	std::vector<MessageCount> frames_per_message; // sorted by id
+	uint64_t untracked_frames; // decoded frames of ids that didn't fit in the per id table
+	std::vector<uint64_t> decode_latency_ns; // LATENCY_BUCKETS entries
+};
+
+bool enabled();
+Snapshot snapshot();
+void reset();
+
+// Frames per second of every message between two snapshots of the same process.
+std::vector<MessageRate> rates(const Snapshot& before, const Snapshot& after);
+
+// Called by the decoders
+void record_decoded(uint32_t message_id, uint64_t latency_ns);
+void record_unknown_id();
+void record_message_too_long();
+
+}
+}
+
+#endif // METRICS_HPP
@@ -0,0 +1,45 @@
+#ifndef NODE_VIEW_HPP
+#define NODE_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/id_filter.hpp>
+#include <libdbc/message.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Libdbc {
+
+/**
+ * A database projected onto one node (ECU). It keeps the messages the node transmits with
+ * all of their signals and, for every other message, only the signals the node receives.
+ * Messages with nothing left are dropped.
+ *
+ * The view copies what it needs so it doesn't depend on the parser after construction.
+ */
+class NodeView {
+public:
+	NodeView(const DbcParser& parser, const std::string& node);
+
+	const std::string& node() const;
+	const std::vector<DecodePlan>& plans() const;
+
+	bool accepts(uint32_t message_id) const;
+	const DecodePlan* find_plan(uint32_t message_id) const;
+
+	// Only the signals kept for this node are written to out_values, in the order of the plan.
+	Message::ParseSignalsStatus parse_message(uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values) const;
+
+private:
+	std::string m_node;
+	std::vector<DecodePlan> m_plans;
+	std::unordered_map<uint32_t, std::size_t> m_id_index;
+	IdFilter m_filter;
+};
+
+}
+
+#endif // NODE_VIEW_HPP
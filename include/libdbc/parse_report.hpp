@@ -0,0 +1,42 @@
+#ifndef PARSE_REPORT_HPP
+#define PARSE_REPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace Libdbc {
+
+/**
+ * Where DbcParser::parse_file spent its time and what the result holds in memory.
+ * Byte counts include the heap blocks owned by the containers and strings, not allocator overhead.
+ */
+struct ParseReport {
+	uint64_t header_ns = 0;
+	uint64_t nodes_ns = 0;
+	uint64_t read_lines_ns = 0;
+	uint64_t messages_ns = 0;
+	uint64_t indexes_ns = 0;
+	uint64_t value_descriptions_ns = 0;
+	uint64_t total_ns = 0;
+
+	std::size_t lines = 0;
+	std::map<std::string, std::size_t> keyword_lines; // first token of every line after BU_
+	std::size_t missed_lines = 0;
+
+	std::size_t message_bytes = 0;
+	std::size_t signal_bytes = 0;
+	std::size_t string_bytes = 0;
+	std::size_t value_description_bytes = 0;
+	std::size_t index_bytes = 0;
+
+	std::size_t total_bytes() const;
+};
+
+std::ostream& operator<<(std::ostream& out, const ParseReport& report);
+
+}
+
+#endif // PARSE_REPORT_HPP
@@ -0,0 +1,33 @@
+#ifndef PARSE_RESULT_HPP
+#define PARSE_RESULT_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace Libdbc {
+
+enum class ParseError {
+	None,
+	NonDbcFileFormat,
+	CannotOpenFile,
+	MissingVersion,
+	MissingBitTiming,
+};
+
+/**
+ * Outcome of DbcParser::try_parse_file. Lines and columns are 1 based and point at where the
+ * expected keyword should have been, they are 0 for errors that aren't about the file contents.
+ */
+struct ParseResult {
+	ParseError error = ParseError::None;
+	std::size_t line = 0;
+	std::size_t column = 0;
+	std::string context; // the offending line, or the file name for file errors
+
+	bool ok() const;
+	std::string message() const;
+};
+
+}
+
+#endif // PARSE_RESULT_HPP
@@ -0,0 +1,123 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Libdbc {
+
+// Receives the frames of a replay. send() is called from the thread running Replay::run().
+class FrameSink {
+public:
+	virtual ~FrameSink() = default;
+
+	// The frame's data is only valid during the call
+	virtual void send(const Frame& frame) = 0;
+};
+
+// Keeps a copy of every frame it receives, together with the steady clock time it arrived at.
+class LocalFrameSink : public FrameSink {
+public:
+	struct Received {
+		uint32_t id;
+		std::vector<uint8_t> data;
+		uint64_t timestamp_ns; // from the log
+		uint64_t sent_ns; // steady clock
+	};
+
+	void send(const Frame& frame) override;
+
+	const std::vector<Received>& frames() const;
+	void clear();
+
+private:
+	std::vector<Received> m_frames;
+};
+
+/**
+ * Plays recorded frames back in timestamp order at their original pace or scaled by a rate.
+ *
+ * Signals can be overridden by qualified name. Only frames of messages with overrides are encoded
+ * again, every other frame goes out with its recorded bytes. The re-encoded payloads are built once
+ * by prepare() so run() only waits and hands frames to the sink. Waiting sleeps until shortly
+ * before a frame is due and spins for the rest, which keeps the jitter down to the clock resolution
+ * at the cost of one busy core during the last part of every wait.
+ */
+class Replay {
+public:
+	// Both must outlive the replay.
+	Replay(const DbcParser& parser, FrameSink& sink);
+
+	void add_frame(const Frame& frame);
+	void add_frames(const std::vector<Frame>& frames);
+	void clear();
+
+	// Returns false for unknown signals. Applies to every frame of the signal's message.
+	bool override_signal(const std::string& qualified_name, double value);
+	void clear_overrides();
+
+	// Sorts the log and encodes the overridden frames, run() does that too when needed. Also clears a previous stop().
+	void prepare();
+
+	/**
+	 * Sends every frame, blocking until the last one went out or stop() was called. A rate of 2
+	 * plays twice as fast, a rate of 0 or below sends everything without waiting.
+	 */
+	void run(double rate = 1.0);
+	/**
+	 * Safe to call from another thread, also before run() starts. Wakes a waiting run() at once.
+	 * The replay stays stopped until prepare() is called again.
+	 */
+	void stop();
+
+	std::size_t frame_count() const;
+	std::size_t reencoded_count() const;
+
+private:
+	struct Entry {
+		uint32_t id;
+		uint64_t timestamp_ns;
+		std::size_t original; // offset into m_recorded
+		std::size_t recorded_size;
+		std::size_t encoded; // offset into m_encoded, npos when sent as recorded
+		std::size_t size; // of the payload that is sent
+	};
+
+	struct Override {
+		SignalPlan signal;
+		double value;
+	};
+
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr uint64_t SPIN_NS = 200000;
+
+	void encode_overrides();
+	// Returns false when stopped before due
+	bool wait_until(uint64_t due);
+
+	const DbcParser& m_parser;
+	FrameSink& m_sink;
+
+	std::vector<Entry> m_entries;
+	std::vector<uint8_t> m_recorded;
+	std::vector<uint8_t> m_encoded;
+	std::unordered_map<uint32_t, std::vector<Override>> m_overrides;
+	std::size_t m_reencoded;
+	bool m_prepared;
+	std::atomic<bool> m_stop;
+	std::mutex m_stop_mutex;
+	std::condition_variable m_stop_changed;
+};
+
+}
+
+#endif // REPLAY_HPP
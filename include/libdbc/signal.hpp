@@ -4,6 +4,8 @@
 
 #include <cstdint>
 #include <iostream>
+#include <libdbc/memory_resource.hpp>
+#include <libdbc/string_pool.hpp>
 #include <string>
 #include <vector>
 
@@ -24,12 +26,18 @@ struct Signal {
 	double offset;
 	double min;
 	double max;
-	std::string unit;
-	std::vector<std::string> receivers;
-	std::vector<ValueDescription> value_descriptions;
+	InternedString unit;
+	Vector<InternedString> receivers;
+	Vector<ValueDescription> value_descriptions;
 
 	Signal() = delete;
 	virtual ~Signal() = default;
+	Signal(const Signal&) = default;
+	Signal(Signal&&) = default;
+	Signal& operator=(const Signal&) = default;
+	Signal& operator=(Signal&&) = default;
+	// Copy whose receivers and value descriptions are allocated from resource, with no spare capacity
+	Signal(const Signal& other, MemoryResource& resource);
 	explicit Signal(std::string name,
 					bool is_multiplexed,
 					uint32_t start_bit,
@@ -42,6 +50,19 @@ struct Signal {
 					double max,
 					std::string unit,
 					std::vector<std::string> receivers);
+	explicit Signal(std::string name,
+					bool is_multiplexed,
+					uint32_t start_bit,
+					uint32_t size,
+					bool is_bigendian,
+					bool is_signed,
+					double factor,
+					double offset,
+					double min,
+					double max,
+					InternedString unit,
+					const std::vector<InternedString>& receivers,
+					MemoryResource& resource = default_resource());
 
 	virtual bool operator==(const Signal& rhs) const;
 	bool operator<(const Signal& rhs) const;
@@ -0,0 +1,133 @@
+#ifndef SIGNAL_EXPORT_HPP
+#define SIGNAL_EXPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <libdbc/dbc.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <string>
+#include <vector>
+
+namespace Libdbc {
+
+enum class ColumnEncoding : uint8_t {
+	Plain, // 8 byte timestamps and doubles
+	Compressed, // varint changes of the timestamp delta and values XORed with the previous one
+};
+
+/**
+ * Columns of every signal in a database, addressed by message index and the value's position.
+ * Shared by the writers below, column i is named "Message.Signal".
+ */
+class SignalColumns {
+public:
+	explicit SignalColumns(const DbcParser& parser);
+
+	std::size_t size() const;
+	const std::string& name(std::size_t column) const;
+	std::size_t first_column(std::size_t message_index) const;
+
+private:
+	std::vector<std::string> m_names;
+	std::vector<std::size_t> m_first_column;
+};
+
+/**
+ * Writes decoded values as one (timestamp, value) series per signal. Values are collected per
+ * column and written in chunks of chunk_size samples, so every chunk holds one signal only.
+ *
+ * Layout, all integers little endian:
+ *   header: "DBCC", u8 version, u8 encoding, u32 columns, per column u16 name length and name
+ *   chunk:  u32 column, u32 samples, u32 payload bytes, payload
+ * A Plain payload is all timestamps as u64 followed by all values as IEEE doubles. A Compressed
+ * payload stores how much each timestamp delta differs from the previous delta as zigzag varints,
+ * followed by the bits of every value XORed with the previous one of the chunk: one byte with the
+ * number of leading and trailing zero bytes, then the remaining bytes.
+ */
+class ColumnarWriter {
+public:
+	ColumnarWriter(const DbcParser& parser, std::ostream& out, ColumnEncoding encoding = ColumnEncoding::Compressed, std::size_t chunk_size = 4096);
+	// Flushes what is left
+	~ColumnarWriter();
+
+	ColumnarWriter(const ColumnarWriter&) = delete;
+	ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+	// Values of one message in the order of its signals, count may cover only the first ones
+	void write(std::size_t message_index, uint64_t timestamp_ns, const double* values, std::size_t count);
+	// Every successfully decoded frame of a parse_batch result, frames is the batch passed to it
+	void write(const Frame* frames, const BatchResult& result);
+	void write(const std::vector<Frame>& frames, const BatchResult& result);
+
+	// Writes every chunk that holds samples
+	void flush();
+	std::size_t bytes_written() const;
+
+private:
+	struct Column {
+		std::vector<uint64_t> timestamps;
+		std::vector<double> values;
+	};
+
+	void write_header();
+	void write_chunk(std::size_t column);
+
+	SignalColumns m_columns;
+	std::ostream& m_out;
+	ColumnEncoding m_encoding;
+	std::size_t m_chunk_size;
+	std::vector<Column> m_data;
+	std::vector<uint8_t> m_buffer;
+	std::size_t m_bytes_written;
+};
+
+// Reads a whole stream written by ColumnarWriter back into memory.
+class ColumnarReader {
+public:
+	struct Column {
+		std::string name;
+		std::vector<uint64_t> timestamps;
+		std::vector<double> values;
+	};
+
+	// Returns false for streams in another format or cut short, the columns read so far are kept
+	bool read(std::istream& in);
+	const std::vector<Column>& columns() const;
+
+private:
+	std::vector<Column> m_columns;
+};
+
+/**
+ * Writes decoded values as "timestamp_ns,Message.Signal,value" rows. Numbers are formatted with
+ * Utils::String::format_double into an internal buffer that goes to the stream in one write
+ * whenever it fills up.
+ */
+class CsvWriter {
+public:
+	CsvWriter(const DbcParser& parser, std::ostream& out, std::size_t buffer_size = 65536);
+	// Flushes what is left
+	~CsvWriter();
+
+	CsvWriter(const CsvWriter&) = delete;
+	CsvWriter& operator=(const CsvWriter&) = delete;
+
+	void write(std::size_t message_index, uint64_t timestamp_ns, const double* values, std::size_t count);
+	void write(const Frame* frames, const BatchResult& result);
+	void write(const std::vector<Frame>& frames, const BatchResult& result);
+
+	void flush();
+
+private:
+	void append(const char* data, std::size_t size);
+
+	SignalColumns m_columns;
+	std::ostream& m_out;
+	std::vector<char> m_buffer;
+	std::size_t m_used;
+};
+
+}
+
+#endif // SIGNAL_EXPORT_HPP
@@ -0,0 +1,89 @@
+#ifndef SIGNAL_STATISTICS_HPP
+#define SIGNAL_STATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_observer.hpp>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Libdbc {
+
+/**
+ * Running min/max/mean/variance and a fixed bucket histogram for every signal of a database,
+ * updated in place as frames are decoded. Attach it to a DbcParser with add_observer().
+ *
+ * Histogram buckets split [Signal::min, Signal::max] evenly. Signals without a usable range
+ * (max <= min) get no buckets. Every decoding thread writes to its own shard and the shards are
+ * merged when summary() is called.
+ */
+class SignalStatistics : public DecodeObserver {
+public:
+	static constexpr std::size_t DEFAULT_BUCKET_COUNT = 16;
+
+	struct Summary {
+		uint64_t count;
+		double min;
+		double max;
+		double mean;
+		double variance; // population variance
+		double stddev;
+
+		double histogram_min;
+		double bucket_width;
+		std::vector<uint64_t> buckets;
+		uint64_t underflow;
+		uint64_t overflow;
+	};
+
+	explicit SignalStatistics(const DbcParser& parser, std::size_t bucket_count = DEFAULT_BUCKET_COUNT);
+
+	void on_decoded(const DecodedMessage& decoded) override;
+
+	Summary summary(const SignalHandle& handle) const;
+	void reset();
+
+private:
+	struct Layout {
+		std::size_t first_bucket;
+		std::size_t bucket_count;
+		double histogram_min;
+		double bucket_width;
+	};
+
+	struct Accumulator {
+		uint64_t count;
+		double mean;
+		double m2;
+		double min;
+		double max;
+		uint64_t underflow;
+		uint64_t overflow;
+	};
+
+	struct Shard {
+		std::mutex mutex;
+		std::vector<Accumulator> accumulators;
+		std::vector<uint64_t> buckets;
+	};
+
+	Shard& local_shard();
+	std::size_t slot_for(const SignalHandle& handle) const;
+
+	uint64_t m_instance_id;
+	std::vector<std::size_t> m_message_offsets;
+	std::vector<Layout> m_layouts;
+	std::size_t m_total_buckets;
+
+	mutable std::mutex m_shards_mutex;
+	std::vector<std::unique_ptr<Shard>> m_shards;
+	std::unordered_map<std::thread::id, Shard*> m_shard_by_thread;
+};
+
+}
+
+#endif // SIGNAL_STATISTICS_HPP
@@ -0,0 +1,80 @@
+#ifndef STRING_POOL_HPP
+#define STRING_POOL_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+namespace Libdbc {
+
+/**
+ * Immutable handle to a string stored in a StringPool. Copies only bump a reference count
+ * and two handles coming from the same pool are equal exactly when they point at the same
+ * storage, so comparisons are a pointer check in the common case.
+ *
+ * Handles keep their text alive on their own, so they stay valid after the pool is cleared
+ * or destroyed.
+ */
+class InternedString {
+public:
+	InternedString() = default;
+	InternedString(const std::string& value);
+	InternedString(const char* value);
+
+	const std::string& str() const;
+	const char* c_str() const;
+	std::size_t size() const;
+	bool empty() const;
+	int compare(const std::string& other) const;
+
+	operator const std::string&() const;
+
+	bool operator==(const InternedString& rhs) const;
+	bool operator!=(const InternedString& rhs) const;
+
+private:
+	friend class StringPool;
+
+	explicit InternedString(std::shared_ptr<const std::string> value);
+
+	std::shared_ptr<const std::string> m_value;
+};
+
+bool operator==(const InternedString& lhs, const std::string& rhs);
+bool operator==(const std::string& lhs, const InternedString& rhs);
+bool operator!=(const InternedString& lhs, const std::string& rhs);
+bool operator!=(const std::string& lhs, const InternedString& rhs);
+bool operator==(const InternedString& lhs, const char* rhs);
+bool operator!=(const InternedString& lhs, const char* rhs);
+
+std::ostream& operator<<(std::ostream& out, const InternedString& str);
+
+class StringPool {
+public:
+	InternedString intern(const std::string& value);
+	InternedString intern(const char* data, std::size_t size);
+
+	std::size_t size() const;
+	void clear();
+
+	// Approximate memory held by the pool: the strings, their heap buffers and the table itself.
+	std::size_t memory_bytes() const;
+
+private:
+	struct Hash {
+		std::size_t operator()(const std::shared_ptr<const std::string>& value) const;
+	};
+
+	struct Equal {
+		bool operator()(const std::shared_ptr<const std::string>& lhs, const std::shared_ptr<const std::string>& rhs) const;
+	};
+
+	std::unordered_set<std::shared_ptr<const std::string>, Hash, Equal> m_strings;
+	std::string m_lookup;
+};
+
+}
+
+#endif // STRING_POOL_HPP
@@ -0,0 +1,81 @@
+#ifndef SUBSCRIPTIONS_HPP
+#define SUBSCRIPTIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/id_filter.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Libdbc {
+
+struct SignalUpdate {
+	SignalHandle signal;
+	double value;
+	uint64_t timestamp_ns;
+};
+
+/**
+ * Callbacks for single signals. Names are resolved once in subscribe() and every subscribed
+ * message gets a dispatch list with a DecodePlan covering only its subscribed signals, so a
+ * frame decodes just what somebody listens to. Frames nobody subscribed to are usually turned
+ * away by one IdFilter test.
+ *
+ * Not thread safe, subscribe and dispatch from the same thread or guard them together. Callbacks
+ * must not subscribe or unsubscribe.
+ */
+class SignalSubscriptions {
+public:
+	using Callback = std::function<void(const SignalUpdate&)>;
+	using Id = std::size_t;
+
+	static constexpr Id invalid_id = static_cast<Id>(-1);
+
+	// The parser must outlive the subscriptions.
+	explicit SignalSubscriptions(const DbcParser& parser);
+
+	// Signals are addressed by their qualified name, "Message.Signal". Returns invalid_id for unknown signals.
+	Id subscribe(const std::string& qualified_name, Callback callback);
+	Id subscribe(const SignalHandle& handle, Callback callback);
+	bool unsubscribe(Id id);
+
+	// Decodes the subscribed signals of the frame and calls their callbacks in signal order, the
+	// callbacks of one signal in subscription order.
+	// Returns false when nobody subscribed to the frame's id.
+	bool dispatch(const Frame& frame);
+
+	std::size_t subscription_count() const;
+
+private:
+	struct Subscription {
+		SignalHandle signal;
+		Callback callback;
+		bool active;
+	};
+
+	struct Dispatch {
+		std::size_t message_index;
+		DecodePlan plan;
+		// Subscriptions of plan signal i are subscribers[first[i]] up to subscribers[first[i + 1]]
+		std::vector<std::size_t> first;
+		std::vector<Id> subscribers;
+	};
+
+	void rebuild(std::size_t message_index);
+
+	const DbcParser& m_parser;
+	std::vector<Subscription> m_subscriptions;
+	std::size_t m_active;
+	std::unordered_map<uint32_t, Dispatch> m_dispatch;
+	IdFilter m_filter;
+	std::vector<double> m_values;
+};
+
+}
+
+#endif // SUBSCRIPTIONS_HPP
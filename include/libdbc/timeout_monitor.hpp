@@ -0,0 +1,88 @@
+#ifndef TIMEOUT_MONITOR_HPP
+#define TIMEOUT_MONITOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_observer.hpp>
+#include <mutex>
+#include <vector>
+
+namespace Libdbc {
+
+/**
+ * Reports periodic messages that stopped arriving. A message times out when nothing was decoded
+ * for cycle_multiplier times its GenMsgCycleTime; messages without a cycle time are ignored.
+ *
+ * Attach it to a DbcParser with add_observer() and call advance() regularly, e.g. from a timer.
+ * Deadlines live in a hierarchical timer wheel, so an arrival and the expiry work per tick don't
+ * depend on the number of messages. The callback fires once per silence, from inside advance(),
+ * and the message is armed again by its next arrival.
+ */
+class TimeoutMonitor : public DecodeObserver {
+public:
+	struct Timeout {
+		const Message* message;
+		std::size_t message_index;
+		uint64_t last_seen_ns; // 0 when the message was never received
+		uint64_t deadline_ns;
+	};
+
+	using Callback = std::function<void(const Timeout&)>;
+
+	static constexpr uint64_t DEFAULT_TICK_NS = 1000000;
+
+	TimeoutMonitor(const DbcParser& parser, Callback callback, double cycle_multiplier = 3.0, uint64_t tick_ns = DEFAULT_TICK_NS);
+
+	void on_decoded(const DecodedMessage& decoded) override;
+
+	// Expect every periodic message within its timeout from now_ns, including the ones never received.
+	void arm_all(uint64_t now_ns);
+	// Fires the callback for every deadline up to now_ns. Timestamps use the clock of the decode path.
+	void advance(uint64_t now_ns);
+
+	bool is_timed_out(std::size_t message_index) const;
+	std::size_t armed_count() const;
+
+private:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr unsigned SLOT_BITS = 8;
+	static constexpr std::size_t SLOTS = std::size_t(1) << SLOT_BITS;
+	static constexpr unsigned LEVELS = 4;
+
+	struct Timer {
+		uint64_t timeout_ns; // 0 for messages that aren't monitored
+		uint64_t last_seen_ns;
+		uint64_t deadline_ns;
+		uint64_t deadline_tick;
+		std::size_t slot; // npos while not armed
+		std::size_t prev;
+		std::size_t next;
+		bool timed_out;
+	};
+
+	void start(uint64_t tick);
+	void arm(std::size_t index, uint64_t deadline_ns);
+	void schedule(std::size_t index, uint64_t earliest_tick);
+	void unlink(std::size_t index);
+	std::size_t detach(std::size_t slot);
+	void expire_slot(std::size_t slot);
+	void cascade_slot(std::size_t slot);
+
+	const DbcParser& m_parser;
+	Callback m_callback;
+	uint64_t m_tick_ns;
+
+	mutable std::mutex m_mutex;
+	bool m_started;
+	uint64_t m_current_tick;
+	std::size_t m_armed;
+	std::vector<Timer> m_timers;
+	std::vector<std::size_t> m_slots; // head of each slot's list, LEVELS * SLOTS entries
+	std::vector<Timeout> m_expired;
+};
+
+}
+
+#endif // TIMEOUT_MONITOR_HPP
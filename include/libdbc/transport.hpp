@@ -0,0 +1,112 @@
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/id_filter.hpp>
+#include <unordered_set>
+#include <vector>
+
+namespace Libdbc {
+
+enum class TransportProtocol {
+	IsoTp, // ISO 15765-2 with normal addressing
+	J1939, // J1939-21 BAM and RTS/CTS transfers
+};
+
+// A reassembled payload. data points into the reassembler and stays valid until its next feed() call.
+struct Transfer {
+	TransportProtocol protocol;
+	uint32_t id; // CAN id for ISO-TP, transported PGN for J1939
+	uint8_t source; // J1939 addresses, 0 for ISO-TP
+	uint8_t destination;
+	const uint8_t* data;
+	std::size_t size;
+	uint64_t timestamp_ns; // of the frame that completed the transfer
+};
+
+struct TransportOptions {
+	std::size_t max_sessions = 256;
+	// Transfers still incomplete after this long since their last frame are dropped by expire()
+	uint64_t timeout_ns = 1000000000;
+};
+
+/**
+ * Listens to segmented transfers and hands back complete payloads, e.g. for
+ * DecodePlan::decode_extended. It only listens, flow control and acknowledgements are left to
+ * the nodes on the bus.
+ *
+ * All buffers and the session table are allocated up front for max_sessions concurrent
+ * transfers of the largest ISO-TP payload, so feeding frames never allocates. New transfers
+ * beyond max_sessions are dropped.
+ */
+class TransportReassembler {
+public:
+	static constexpr std::size_t MAX_PAYLOAD = 4095; // ISO-TP on classic CAN, J1939 tops out at 1785
+
+	explicit TransportReassembler(const TransportOptions& options = TransportOptions());
+
+	// ISO-TP is only recognized on these ids
+	void add_isotp_id(uint32_t id);
+	// Extended ids with the TP.CM and TP.DT PGNs are read as J1939 transport
+	void enable_j1939(bool enable = true);
+
+	// Returns true and fills completed when the frame finished a transfer. Single frames complete right away.
+	bool feed(const Frame& frame, Transfer& completed);
+	// Drops the transfers whose last frame is older than the timeout
+	void expire(uint64_t now_ns);
+
+	std::size_t active_sessions() const;
+	// Transfers dropped for sequence errors, aborts, timeouts or a full session table
+	std::size_t dropped() const;
+
+private:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr uint64_t EMPTY_KEY = ~0ULL;
+
+	struct Session {
+		uint64_t key;
+		TransportProtocol protocol;
+		uint32_t id;
+		uint8_t source;
+		uint8_t destination;
+		std::size_t size;
+		std::size_t received;
+		uint8_t next_sequence;
+		uint64_t last_ns;
+	};
+
+	bool feed_isotp(const Frame& frame, Transfer& completed);
+	bool feed_j1939(const Frame& frame, Transfer& completed);
+
+	std::size_t open(uint64_t key, const Frame& frame);
+	void close(std::size_t session);
+	bool append(std::size_t session, const uint8_t* data, std::size_t size, const Frame& frame, Transfer& completed);
+
+	std::size_t find(uint64_t key) const;
+	std::size_t bucket(uint64_t key) const;
+	void erase_key(uint64_t key);
+
+	TransportOptions m_options;
+	IdFilter m_isotp_filter;
+	std::unordered_set<uint32_t> m_isotp_ids;
+	bool m_j1939;
+
+	std::vector<Session> m_sessions;
+	std::vector<uint8_t> m_buffers; // MAX_PAYLOAD bytes per session
+	std::vector<std::size_t> m_free;
+	std::size_t m_completed; // session handed out by the last feed, released by the next one
+
+	// Open addressing index from session key to session, twice as many buckets as sessions
+	std::vector<uint64_t> m_keys;
+	std::vector<std::size_t> m_values;
+	std::size_t m_mask;
+
+	std::size_t m_active;
+	std::size_t m_dropped;
+};
+
+}
+
+#endif // TRANSPORT_HPP
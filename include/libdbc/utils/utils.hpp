@@ -2,8 +2,9 @@
 #ifndef UTILS_HPP
 #define UTILS_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
-#include <sstream>
 #include <string>
 
 namespace Utils {
@@ -19,28 +20,58 @@ public:
 	 * @param  line   [description]
 	 * @return        [description]
 	 */
-	static std::istream& get_line(std::istream& stream, std::string& line);
+	static std::istream& get_line(std::istream& stream, std::string& line, std::size_t* line_number = nullptr);
 
-	static std::istream& get_next_non_blank_line(std::istream& stream, std::string& line);
+	// When line_number is given it is incremented for every line read from the stream.
+	static std::istream& get_next_non_blank_line(std::istream& stream, std::string& line, std::size_t* line_number = nullptr);
 
-	static std::istream& skip_to_next_blank_line(std::istream& stream, std::string& line);
+	static std::istream& skip_to_next_blank_line(std::istream& stream, std::string& line, std::size_t* line_number = nullptr);
 };
 
 class String {
 public:
 	static std::string trim(const std::string& line);
 
+	/**
+	 * Calls func(data, size) for every token in [first, last) without copying them out.
+	 * Follows std::getline semantics: empty tokens are kept except for a trailing one.
+	 */
+	template<class Func>
+	static void for_each_token(const char* first, const char* last, char delim, Func func) {
+		while (first < last) {
+			const char* end = first;
+			while (end != last && *end != delim) {
+				++end;
+			}
+			func(first, static_cast<std::size_t>(end - first));
+			first = (end == last) ? last : end + 1;
+		}
+	}
+
 	template<class Container>
 	static void split(const std::string& str, Container& cont, char delim = ' ') {
-		std::stringstream stream(str);
-		std::string token;
-
-		while (std::getline(stream, token, delim)) {
-			cont.push_back(token);
-		}
+		for_each_token(str.data(), str.data() + str.size(), delim, [&cont](const char* data, std::size_t size) {
+			cont.push_back(std::string(data, size));
+		});
 	}
 
+	// Shell style wildcard match. '*' matches any run of characters and '?' exactly one.
+	static bool glob_match(const std::string& pattern, const std::string& text);
+
 	static double convert_to_double(const std::string& value, double default_value = 0);
+
+	// Decimal digits only. Returns default_value for anything else or when the value overflows, never throws.
+	static uint64_t convert_to_unsigned(const std::string& value, uint64_t default_value = 0);
+
+	static constexpr std::size_t FORMAT_DOUBLE_SIZE = 32;
+
+	/**
+	 * Writes value to out without a terminating null and returns the number of characters, at most
+	 * FORMAT_DOUBLE_SIZE. Values with up to 9 decimals get their shortest exact form, e.g. 0.1,
+	 * everything else 17 significant digits. Always uses '.' whatever the locale, and the text
+	 * parses back to the same double.
+	 */
+	static std::size_t format_double(double value, char* out);
 };
 
 }
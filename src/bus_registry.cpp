@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <libdbc/bus_registry.hpp>
+#include <libdbc/dbc.hpp>
+#include <libdbc/message.hpp>
+#include <libdbc/parse_result.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Libdbc {
+
+constexpr std::size_t BusRegistry::npos;
+
+uint64_t BusRegistry::key(uint32_t channel, uint32_t message_id) {
+	return (static_cast<uint64_t>(channel) << 32) | message_id;
+}
+
+void BusRegistry::add_channel(uint32_t channel, const std::string& file_name) {
+	auto& entry = m_channels[channel];
+	entry.file_name = file_name;
+	entry.database = npos;
+	entry.result = ParseResult();
+}
+
+bool BusRegistry::load(unsigned max_threads) {
+	m_databases.clear();
+	m_index.clear();
+
+	// Read every file up front so identical contents are parsed once, whatever the file is called
+	std::vector<std::string> contents;
+	std::vector<ParseResult> results;
+	std::unordered_map<std::string, std::size_t> known_contents;
+	for (auto& channel : m_channels) {
+		auto& entry = channel.second;
+		entry.database = npos;
+		entry.result = ParseResult();
+
+		const auto& file_name = entry.file_name;
+		const std::string extension = ".dbc";
+		if (file_name.size() < extension.size() || file_name.compare(file_name.size() - extension.size(), extension.size(), extension) != 0) {
+			entry.result.error = ParseError::NonDbcFileFormat;
+			entry.result.context = file_name;
+			continue;
+		}
+
+		std::ifstream file(file_name.c_str());
+		if (!file.is_open()) {
+			entry.result.error = ParseError::CannotOpenFile;
+			entry.result.context = file_name;
+			continue;
+		}
+		std::ostringstream text;
+		text << file.rdbuf();
+
+		auto inserted = known_contents.emplace(text.str(), contents.size());
+		if (inserted.second) {
+			contents.push_back(inserted.first->first);
+		}
+		entry.database = inserted.first->second;
+	}
+
+	m_databases.resize(contents.size());
+	results.resize(contents.size());
+
+	std::atomic<std::size_t> next(0);
+	auto parse_next = [&]() {
+		for (std::size_t i = next++; i < contents.size(); i = next++) {
+			std::unique_ptr<DbcParser> parser(new DbcParser());
+			std::istringstream stream(contents[i]);
+			results[i] = parser->try_parse_file(stream);
+			m_databases[i] = std::move(parser);
+		}
+	};
+
+	std::size_t thread_count = max_threads == 0 ? std::thread::hardware_concurrency() : max_threads;
+	thread_count = std::max<std::size_t>(1, std::min(thread_count, contents.size()));
+	std::vector<std::thread> workers;
+	for (std::size_t i = 1; i < thread_count; i++) {
+		workers.emplace_back(parse_next);
+	}
+	parse_next();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+
+	bool ok = true;
+	for (auto& channel : m_channels) {
+		auto& entry = channel.second;
+		if (entry.database != npos) {
+			entry.result = results[entry.database];
+			if (!entry.result.ok()) {
+				entry.database = npos;
+			}
+		}
+		if (entry.database == npos) {
+			ok = false;
+			continue;
+		}
+
+		const auto* parser = m_databases[entry.database].get();
+		const auto& messages = parser->get_messages();
+		const auto& plans = parser->get_decode_plans();
+		for (std::size_t i = 0; i < messages.size(); i++) {
+			m_index.emplace(key(channel.first, messages[i].id()), Entry{channel.first, parser, &messages[i], &plans[i]});
+		}
+	}
+	return ok;
+}
+
+const ParseResult* BusRegistry::channel_result(uint32_t channel) const {
+	auto found = m_channels.find(channel);
+	return found == m_channels.end() ? nullptr : &found->second.result;
+}
+
+const DbcParser* BusRegistry::database(uint32_t channel) const {
+	auto found = m_channels.find(channel);
+	if (found == m_channels.end() || found->second.database == npos) {
+		return nullptr;
+	}
+	return m_databases[found->second.database].get();
+}
+
+std::size_t BusRegistry::channel_count() const {
+	return m_channels.size();
+}
+
+std::size_t BusRegistry::database_count() const {
+	return m_databases.size();
+}
+
+const BusRegistry::Entry* BusRegistry::find(uint32_t channel, uint32_t message_id) const {
+	auto found = m_index.find(key(channel, message_id));
+	return found == m_index.end() ? nullptr : &found->second;
+}
+
+Message::ParseSignalsStatus BusRegistry::decode(uint32_t channel, uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values) const {
+	auto found = m_index.find(key(channel, message_id));
+	if (found == m_index.end()) {
+		return Message::ParseSignalsStatus::ErrorUnknownID;
+	}
+	return found->second.plan->decode(data, out_values);
+}
+
+}
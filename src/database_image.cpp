@@ -0,0 +1,403 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <libdbc/database_image.hpp>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/message.hpp>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DBC_HAS_MMAP
+#endif
+
+namespace Libdbc {
+
+static_assert(std::is_trivially_copyable<SignalPlan>::value, "SignalPlan is copied into images as raw bytes");
+
+namespace {
+
+constexpr char IMAGE_MAGIC[8] = {'L', 'I', 'B', 'D', 'B', 'C', 'I', 'M'};
+constexpr uint32_t IMAGE_VERSION = 1;
+constexpr std::size_t IMAGE_ALIGNMENT = 8;
+
+struct ImageHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t signal_plan_size; // a different build lays out SignalPlan differently
+	uint64_t generation;
+	uint64_t total_size;
+	uint64_t message_count;
+	uint64_t signal_count;
+	uint64_t messages_offset;
+	uint64_t plans_offset;
+	uint64_t signals_offset;
+	uint64_t strings_offset;
+	uint64_t strings_size;
+};
+
+std::size_t align_up(std::size_t value) {
+	return (value + IMAGE_ALIGNMENT - 1) / IMAGE_ALIGNMENT * IMAGE_ALIGNMENT;
+}
+
+// Bytes from offset to offset + count * element_size all lie inside total
+bool table_fits(uint64_t offset, uint64_t count, std::size_t element_size, uint64_t total) {
+	if (offset % IMAGE_ALIGNMENT != 0 || offset > total) {
+		return false;
+	}
+	return count <= (total - offset) / element_size;
+}
+
+// Plans are used without further checks by decode, so they must stay inside a classic 8 byte payload
+bool plan_fits(const SignalPlan& plan) {
+	if (static_cast<uint8_t>(plan.layout) > static_cast<uint8_t>(SignalPlan::Layout::BigEndian32) || plan.size > 64 || plan.start_bit >= 64
+		|| uint64_t(plan.first_byte) + plan.byte_count > 8) {
+		return false;
+	}
+	// Big endian signals run from their most significant bit, which start_bit names, towards higher bytes
+	return plan.is_bigendian ? plan.end_byte() <= 8 : plan.start_bit + plan.size <= 64;
+}
+
+}
+
+struct DatabaseView::ImageMessage {
+	uint32_t id;
+	uint32_t name; // offsets into the string table
+	uint32_t size;
+	uint32_t cycle_time;
+	uint64_t first_signal;
+	uint64_t signal_count;
+};
+
+struct DatabaseView::ImageSignal {
+	uint32_t name;
+	uint32_t unit;
+};
+
+std::vector<uint8_t> DatabaseImage::build(const DbcParser& parser, uint64_t generation) {
+	std::vector<const Message*> messages;
+	for (const auto& message : parser.get_messages()) {
+		if (parser.find_message(message.id()) == &message) {
+			messages.push_back(&message);
+		}
+	}
+	std::stable_sort(messages.begin(), messages.end(), [](const Message* lhs, const Message* rhs) {
+		return lhs->id() < rhs->id();
+	});
+
+	std::string strings;
+	auto add_string = [&strings](const std::string& value) {
+		const auto offset = static_cast<uint32_t>(strings.size());
+		strings += value;
+		strings += '\0';
+		return offset;
+	};
+
+	std::vector<DatabaseView::ImageMessage> image_messages;
+	std::vector<SignalPlan> plans;
+	std::vector<DatabaseView::ImageSignal> image_signals;
+	for (const auto* message : messages) {
+		const auto& signals = message->get_signals();
+		const bool classic = std::all_of(signals.begin(), signals.end(), [](const Signal& signal) {
+			return plan_fits(SignalPlan(signal, 0));
+		});
+		if (!classic) {
+			continue;
+		}
+		image_messages.push_back(DatabaseView::ImageMessage{message->id(), add_string(message->name()), message->size(), message->cycle_time(), plans.size(), signals.size()});
+		for (std::size_t i = 0; i < signals.size(); i++) {
+			plans.push_back(SignalPlan(signals[i], i));
+			image_signals.push_back(DatabaseView::ImageSignal{add_string(signals[i].name), add_string(signals[i].unit)});
+		}
+	}
+
+	ImageHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+	header.version = IMAGE_VERSION;
+	header.signal_plan_size = sizeof(SignalPlan);
+	header.generation = generation;
+	header.message_count = image_messages.size();
+	header.signal_count = plans.size();
+	header.messages_offset = align_up(sizeof(ImageHeader));
+	header.plans_offset = align_up(header.messages_offset + image_messages.size() * sizeof(DatabaseView::ImageMessage));
+	header.signals_offset = align_up(header.plans_offset + plans.size() * sizeof(SignalPlan));
+	header.strings_offset = align_up(header.signals_offset + image_signals.size() * sizeof(DatabaseView::ImageSignal));
+	header.strings_size = strings.size();
+	header.total_size = align_up(header.strings_offset + strings.size());
+
+	std::vector<uint8_t> image(static_cast<std::size_t>(header.total_size), 0);
+	std::memcpy(image.data(), &header, sizeof(header));
+	if (!image_messages.empty()) {
+		std::memcpy(image.data() + header.messages_offset, image_messages.data(), image_messages.size() * sizeof(DatabaseView::ImageMessage));
+		std::memcpy(image.data() + header.plans_offset, plans.data(), plans.size() * sizeof(SignalPlan));
+	}
+	if (!image_signals.empty()) {
+		std::memcpy(image.data() + header.signals_offset, image_signals.data(), image_signals.size() * sizeof(DatabaseView::ImageSignal));
+	}
+	if (!strings.empty()) {
+		std::memcpy(image.data() + header.strings_offset, strings.data(), strings.size());
+	}
+	return image;
+}
+
+bool DatabaseImage::publish(const DbcParser& parser, uint64_t generation, const std::string& path) {
+	const auto image = build(parser, generation);
+	const std::string temporary = path + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+		if (!file) {
+			std::remove(temporary.c_str());
+			return false;
+		}
+	}
+	if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+		std::remove(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool DatabaseView::attach(const void* data, std::size_t size) {
+	detach();
+
+	const auto* bytes = static_cast<const uint8_t*>(data);
+	if (bytes == nullptr || reinterpret_cast<std::uintptr_t>(bytes) % IMAGE_ALIGNMENT != 0 || size < sizeof(ImageHeader)) {
+		return false;
+	}
+
+	ImageHeader header;
+	std::memcpy(&header, bytes, sizeof(header));
+	if (std::memcmp(header.magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) != 0 || header.version != IMAGE_VERSION || header.signal_plan_size != sizeof(SignalPlan)) {
+		return false;
+	}
+
+	const uint64_t total = header.total_size;
+	if (total > size || !table_fits(header.messages_offset, header.message_count, sizeof(ImageMessage), total)
+		|| !table_fits(header.plans_offset, header.signal_count, sizeof(SignalPlan), total)
+		|| !table_fits(header.signals_offset, header.signal_count, sizeof(ImageSignal), total)
+		|| header.strings_offset > total || header.strings_size > total - header.strings_offset) {
+		return false;
+	}
+
+	// Strings are read as C strings, so the table has to end in a terminator
+	const auto* strings = reinterpret_cast<const char*>(bytes + header.strings_offset);
+	const auto strings_size = static_cast<std::size_t>(header.strings_size);
+	if (strings_size > 0 && strings[strings_size - 1] != '\0') {
+		return false;
+	}
+
+	const auto* messages = reinterpret_cast<const ImageMessage*>(bytes + header.messages_offset);
+	const auto* plans = reinterpret_cast<const SignalPlan*>(bytes + header.plans_offset);
+	const auto* signals = reinterpret_cast<const ImageSignal*>(bytes + header.signals_offset);
+	for (std::size_t i = 0; i < header.message_count; i++) {
+		const auto& message = messages[i];
+		if (message.first_signal > header.signal_count || message.signal_count > header.signal_count - message.first_signal || message.name >= strings_size) {
+			return false;
+		}
+		// find_message relies on the order
+		if (i > 0 && messages[i - 1].id >= message.id) {
+			return false;
+		}
+	}
+	for (std::size_t i = 0; i < header.signal_count; i++) {
+		if (signals[i].name >= strings_size || signals[i].unit >= strings_size || !plan_fits(plans[i])) {
+			return false;
+		}
+	}
+
+	m_data = bytes;
+	m_generation = header.generation;
+	m_message_count = static_cast<std::size_t>(header.message_count);
+	m_messages = messages;
+	m_plans = plans;
+	m_signals = signals;
+	m_strings = strings;
+	return true;
+}
+
+void DatabaseView::detach() {
+	*this = DatabaseView();
+}
+
+bool DatabaseView::is_attached() const {
+	return m_data != nullptr;
+}
+
+uint64_t DatabaseView::generation() const {
+	return m_generation;
+}
+
+std::size_t DatabaseView::message_count() const {
+	return m_message_count;
+}
+
+std::size_t DatabaseView::find_message(uint32_t message_id) const {
+	const ImageMessage* end = m_messages + m_message_count;
+	const ImageMessage* found = std::lower_bound(m_messages, end, message_id, [](const ImageMessage& message, uint32_t id) {
+		return message.id < id;
+	});
+	if (found == end || found->id != message_id) {
+		return npos;
+	}
+	return static_cast<std::size_t>(found - m_messages);
+}
+
+const DatabaseView::ImageMessage& DatabaseView::message_at(std::size_t message) const {
+	return m_messages[message];
+}
+
+const char* DatabaseView::string_at(uint32_t offset) const {
+	return m_strings + offset;
+}
+
+uint32_t DatabaseView::message_id(std::size_t message) const {
+	return message_at(message).id;
+}
+
+const char* DatabaseView::message_name(std::size_t message) const {
+	return string_at(message_at(message).name);
+}
+
+uint8_t DatabaseView::message_size(std::size_t message) const {
+	return static_cast<uint8_t>(message_at(message).size);
+}
+
+uint32_t DatabaseView::cycle_time(std::size_t message) const {
+	return message_at(message).cycle_time;
+}
+
+std::size_t DatabaseView::signal_count(std::size_t message) const {
+	return static_cast<std::size_t>(message_at(message).signal_count);
+}
+
+const SignalPlan* DatabaseView::signals(std::size_t message) const {
+	return m_plans + message_at(message).first_signal;
+}
+
+const char* DatabaseView::signal_name(std::size_t message, std::size_t signal) const {
+	return string_at(m_signals[message_at(message).first_signal + signal].name);
+}
+
+const char* DatabaseView::signal_unit(std::size_t message, std::size_t signal) const {
+	return string_at(m_signals[message_at(message).first_signal + signal].unit);
+}
+
+Message::ParseSignalsStatus DatabaseView::decode(uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values) const {
+	const std::size_t message = find_message(message_id);
+	if (message == npos) {
+		return Message::ParseSignalsStatus::ErrorUnknownID;
+	}
+
+	const std::size_t first = out_values.size();
+	out_values.resize(first + signal_count(message));
+	const auto status = decode(message_id, data.data(), data.size(), out_values.data() + first);
+	if (status != Message::ParseSignalsStatus::Success) {
+		out_values.resize(first);
+	}
+	return status;
+}
+
+Message::ParseSignalsStatus DatabaseView::decode(uint32_t message_id, const uint8_t* data, std::size_t size, double* values) const {
+	const std::size_t message = find_message(message_id);
+	if (message == npos) {
+		return Message::ParseSignalsStatus::ErrorUnknownID;
+	}
+	if (size > sizeof(uint64_t)) {
+		return Message::ParseSignalsStatus::ErrorMessageToLong;
+	}
+
+	Payload payload(data, size);
+	const SignalPlan* plans = signals(message);
+	for (std::size_t i = 0; i < signal_count(message); i++) {
+		values[i] = plans[i].decode(payload);
+	}
+	return Message::ParseSignalsStatus::Success;
+}
+
+MappedImage::~MappedImage() {
+	unmap();
+}
+
+bool MappedImage::open(const std::string& path) {
+	close();
+	m_path = path;
+	return map(path, 0);
+}
+
+void MappedImage::close() {
+	unmap();
+	m_path.clear();
+}
+
+bool MappedImage::refresh() {
+	if (m_path.empty()) {
+		return false;
+	}
+	return map(m_path, m_view.is_attached() ? m_view.generation() + 1 : 0);
+}
+
+const DatabaseView& MappedImage::view() const {
+	return m_view;
+}
+
+bool MappedImage::map(const std::string& path, uint64_t min_generation) {
+#if defined(DBC_HAS_MMAP)
+	const int descriptor = ::open(path.c_str(), O_RDONLY);
+	if (descriptor < 0) {
+		return false;
+	}
+
+	struct stat status;
+	void* address = MAP_FAILED;
+	std::size_t size = 0;
+	if (::fstat(descriptor, &status) == 0 && status.st_size > 0) {
+		size = static_cast<std::size_t>(status.st_size);
+		address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+	}
+	// The mapping stays valid after the descriptor is closed
+	::close(descriptor);
+	if (address == MAP_FAILED) {
+		return false;
+	}
+
+	DatabaseView view;
+	if (!view.attach(address, size) || view.generation() < min_generation) {
+		::munmap(address, size);
+		return false;
+	}
+
+	unmap();
+	m_address = address;
+	m_size = size;
+	m_view = view;
+	return true;
+#else
+	(void)path;
+	(void)min_generation;
+	return false;
+#endif
+}
+
+void MappedImage::unmap() {
+	m_view.detach();
+#if defined(DBC_HAS_MMAP)
+	if (m_address != nullptr) {
+		::munmap(m_address, m_size);
+	}
+#endif
+	m_address = nullptr;
+	m_size = 0;
+}
+
+}
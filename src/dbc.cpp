@@ -1,14 +1,26 @@
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <fstream>
 #include <istream>
 #include <libdbc/dbc.hpp>
+#include <libdbc/decode_observer.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/frame_batch.hpp>
 #include <libdbc/exceptions/error.hpp>
+#include <libdbc/fixed_point.hpp>
+#include <libdbc/memory_resource.hpp>
 #include <libdbc/message.hpp>
+#include <libdbc/metrics.hpp>
+#include <libdbc/parse_report.hpp>
+#include <libdbc/parse_result.hpp>
 #include <libdbc/signal.hpp>
+#include <libdbc/string_pool.hpp>
 #include <libdbc/utils/utils.hpp>
 #include <regex>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Libdbc {
@@ -50,14 +62,44 @@ constexpr unsigned MESSAGE_NAME_GROUP = 3;
 constexpr unsigned MESSAGE_SIZE_GROUP = 4;
 constexpr unsigned MESSAGE_NODE_GROUP = 5;
 
+// Zero unless the report is collected, reading the clock isn't free on every platform
+static uint64_t parse_clock_ns(bool collect_report) {
+	if (!collect_report) {
+		return 0;
+	}
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
 struct Value {
 	uint32_t can_id;
 	std::string signal_name;
 	std::vector<Signal::ValueDescription> value_descriptions;
 };
 
+constexpr std::size_t SignalHandle::npos;
+
+SignalHandle::SignalHandle(std::size_t message_index, std::size_t signal_index)
+	: message_index(message_index)
+	, signal_index(signal_index) {
+}
+
+bool SignalHandle::is_valid() const {
+	return message_index != npos && signal_index != npos;
+}
+
+bool SignalHandle::operator==(const SignalHandle& rhs) const {
+	return message_index == rhs.message_index && signal_index == rhs.signal_index;
+}
+
 DbcParser::DbcParser()
-	: version_re("^(VERSION)\\s\"(.*)\"")
+	: DbcParser(default_resource()) {
+}
+
+DbcParser::DbcParser(MemoryResource& resource)
+	: memory_resource(&resource)
+	, messages(Allocator<Message>(resource))
+	, version_re("^(VERSION)\\s\"(.*)\"")
 	, bit_timing_re("^(BS_:)")
 	, name_space_re("^(NS_)\\s\\:")
 	, node_re("^(BU_:)\\s?((?:[\\w]+?\\s?)*)?")
@@ -67,37 +109,129 @@ DbcParser::DbcParser()
 	// NOTE: No multiplex support yet
 	signal_re(std::string("^") + whiteSpace + signalIdentifierPattern + whiteSpace + namePattern + whiteSpace + "\\:" + whiteSpace + bitStartPattern + "\\|"
 			  + lengthPattern + "\\@" + byteOrderPattern + signPattern + whiteSpace + offsetScalePattern + whiteSpace + minMaxPattern + whiteSpace + unitPattern
-			  + whiteSpace + receiverPattern) {
+			  + whiteSpace + receiverPattern)
+	, cycle_time_re("^BA_\\s+\"GenMsgCycleTime\"\\s+BO_\\s+(\\d+)\\s+(\\d+)\\s*;")
+	, cycle_time_default_re("^BA_DEF_DEF_\\s+\"GenMsgCycleTime\"\\s+(\\d+)\\s*;")
+	, missed_lines(Allocator<std::string>(resource)) {
 }
 
-void DbcParser::parse_file(std::istream& stream) {
+ParseResult DbcParser::parse_stream(std::istream& stream) {
 	std::string line;
 	std::vector<std::string> lines;
 
+	nodes.clear();
 	messages.clear();
+	decode_plans.clear();
+	fixed_point_plans.clear();
+	range_violation_counts.clear();
+	missed_lines.clear();
+	missed_line_positions.clear();
+	missed_line_count = 0;
+	database_metadata.clear();
+	string_pool.clear();
+	message_id_index.clear();
+	message_name_index.clear();
+	signal_name_index.clear();
+	report = ParseReport();
+
+	std::size_t line_number = 0;
+	const auto start = parse_clock_ns(collect_report);
+	auto result = parse_dbc_header(stream, line_number);
+	if (!result.ok()) {
+		return result;
+	}
+	const auto header_done = parse_clock_ns(collect_report);
+	parse_dbc_nodes(stream, line_number);
+	const auto nodes_done = parse_clock_ns(collect_report);
 
-	parse_dbc_header(stream);
-	parse_dbc_nodes(stream);
-
+	// Same as reading with get_next_non_blank_line, one line at a time so each one's position is known
+	std::vector<LinePosition> positions;
+	const bool track_offsets = unused_lines_policy == UnusedLines::Positions;
 	while (!stream.eof()) {
-		Utils::StreamHandler::get_next_non_blank_line(stream, line);
+		const int64_t offset = track_offsets ? static_cast<int64_t>(stream.tellg()) : -1;
+		Utils::StreamHandler::get_line(stream, line, &line_number);
+		if (line.find_first_not_of(" \t\r\n\f\v") == std::string::npos && !stream.eof()) {
+			continue;
+		}
 		lines.push_back(line);
+		positions.push_back(LinePosition{line_number, offset});
+	}
+	const auto lines_done = parse_clock_ns(collect_report);
+
+	parse_dbc_messages(lines, positions);
+
+	if (collect_report) {
+		report.header_ns = header_done - start;
+		report.nodes_ns = nodes_done - header_done;
+		report.read_lines_ns = lines_done - nodes_done;
+		report.total_ns = parse_clock_ns(collect_report) - start;
+
+		report.lines = lines.size();
+		for (const auto& text : lines) {
+			const auto first = text.find_first_not_of(" \t");
+			if (first == std::string::npos) {
+				continue;
+			}
+			const auto last = text.find_first_of(" \t:", first);
+			report.keyword_lines[text.substr(first, last == std::string::npos ? std::string::npos : last - first)]++;
+		}
+		report.missed_lines = missed_line_count;
+		account_memory();
 	}
+	return result;
+}
 
-	parse_dbc_messages(lines);
+void DbcParser::parse_file(std::istream& stream) {
+	throw_on_error(parse_stream(stream));
 }
 
 void DbcParser::parse_file(const std::string& file_name) {
 	auto extension = get_extension(file_name);
 	if (extension != ".dbc") {
-		throw NonDbcFileFormatError(file_name, extension);
+		DBC_THROW(NonDbcFileFormatError(file_name, extension));
 	}
 
+	// An unreadable file keeps failing on the missing version like it always has
 	std::ifstream stream(file_name.c_str());
 
 	parse_file(stream);
 }
 
+ParseResult DbcParser::try_parse_file(const std::string& file_name) {
+	ParseResult result;
+	if (get_extension(file_name) != ".dbc") {
+		result.error = ParseError::NonDbcFileFormat;
+		result.context = file_name;
+		return result;
+	}
+
+	std::ifstream stream(file_name.c_str());
+	if (!stream.is_open()) {
+		result.error = ParseError::CannotOpenFile;
+		result.context = file_name;
+		return result;
+	}
+	return parse_stream(stream);
+}
+
+ParseResult DbcParser::try_parse_file(std::istream& stream) {
+	return parse_stream(stream);
+}
+
+void DbcParser::throw_on_error(const ParseResult& result) {
+	switch (result.error) {
+	case ParseError::MissingVersion:
+		DBC_THROW(DbcFileIsMissingVersion(result.context));
+	case ParseError::MissingBitTiming:
+		DBC_THROW(DbcFileIsMissingBitTiming(result.context));
+	case ParseError::NonDbcFileFormat:
+		DBC_THROW(NonDbcFileFormatError(result.context, get_extension(result.context)));
+	case ParseError::CannotOpenFile:
+	case ParseError::None:
+		break;
+	}
+}
+
 std::string DbcParser::get_extension(const std::string& file_name) {
 	std::size_t dot = file_name.find_last_of(".");
 	if (dot != std::string::npos) {
@@ -107,53 +241,393 @@ std::string DbcParser::get_extension(const std::string& file_name) {
 	return "";
 }
 
-std::string DbcParser::get_version() const {
+const std::string& DbcParser::get_version() const {
 	return version;
 }
 
-std::vector<std::string> DbcParser::get_nodes() const {
+const std::vector<std::string>& DbcParser::get_nodes() const {
 	return nodes;
 }
 
-std::vector<Libdbc::Message> DbcParser::get_messages() const {
+const Vector<Message>& DbcParser::get_messages() const {
 	return messages;
 }
 
-Message::ParseSignalsStatus DbcParser::parse_message(const uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values) {
+const Message* DbcParser::find_message(uint32_t message_id) const {
+	auto found = message_id_index.find(message_id);
+	if (found == message_id_index.end()) {
+		return nullptr;
+	}
+	return &messages[found->second];
+}
+
+const Message* DbcParser::find_message(const std::string& name) const {
+	auto found = message_name_index.find(name);
+	if (found == message_name_index.end()) {
+		return nullptr;
+	}
+	return &messages[found->second];
+}
+
+SignalHandle DbcParser::find_signal_handle(const std::string& qualified_name) const {
+	auto found = signal_name_index.find(qualified_name);
+	if (found == signal_name_index.end()) {
+		return SignalHandle{};
+	}
+	return found->second;
+}
+
+const Signal* DbcParser::find_signal(const std::string& qualified_name) const {
+	auto handle = find_signal_handle(qualified_name);
+	if (!handle.is_valid()) {
+		return nullptr;
+	}
+	return &get_signal(handle);
+}
+
+const Signal& DbcParser::get_signal(const SignalHandle& handle) const {
+	return messages.at(handle.message_index).get_signals().at(handle.signal_index);
+}
+
+std::vector<const Message*> DbcParser::search_messages(const std::string& pattern) const {
+	std::vector<const Message*> found;
 	for (const auto& message : messages) {
-		if (message.id() == message_id) {
-			return message.parse_signals(data, out_values);
+		if (Utils::String::glob_match(pattern, message.name())) {
+			found.push_back(&message);
+		}
+	}
+	return found;
+}
+
+std::vector<SignalHandle> DbcParser::search_signals(const std::string& pattern) const {
+	std::vector<SignalHandle> found;
+
+	// When the message part has no wildcards only that message has to be looked at
+	const auto wildcard = pattern.find_first_of("*?");
+	const auto dot = pattern.find('.');
+	if (dot != std::string::npos && dot < wildcard) {
+		auto message = message_name_index.find(pattern.substr(0, dot));
+		if (message == message_name_index.end()) {
+			return found;
+		}
+
+		const auto signal_pattern = pattern.substr(dot + 1);
+		const auto& signals = messages[message->second].get_signals();
+		for (std::size_t i = 0; i < signals.size(); i++) {
+			if (Utils::String::glob_match(signal_pattern, signals[i].name)) {
+				found.push_back(SignalHandle{message->second, i});
+			}
+		}
+		return found;
+	}
+
+	std::string qualified_name;
+	for (std::size_t msg = 0; msg < messages.size(); msg++) {
+		const auto& signals = messages[msg].get_signals();
+		for (std::size_t i = 0; i < signals.size(); i++) {
+			qualified_name = messages[msg].name();
+			qualified_name += '.';
+			qualified_name += signals[i].name;
+			if (Utils::String::glob_match(pattern, qualified_name)) {
+				found.push_back(SignalHandle{msg, i});
+			}
+		}
+	}
+	return found;
+}
+
+Message::ParseSignalsStatus DbcParser::parse_message(const uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values) {
+	uint64_t timestamp_ns = 0;
+	if (!observers.empty()) {
+		auto now = std::chrono::steady_clock::now().time_since_epoch();
+		timestamp_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+	}
+	return parse_message(message_id, data, out_values, timestamp_ns);
+}
+
+Message::ParseSignalsStatus DbcParser::parse_message(const uint32_t message_id,
+													 const std::vector<uint8_t>& data,
+													 std::vector<double>& out_values,
+													 uint64_t timestamp_ns) {
+	DBC_METRICS_ONLY(const auto decode_start = std::chrono::steady_clock::now());
+
+	auto found = message_id_index.find(message_id);
+	if (found == message_id_index.end()) {
+		DBC_METRICS_ONLY(Metrics::record_unknown_id());
+		return Message::ParseSignalsStatus::ErrorUnknownID;
+	}
+
+	const auto& message = messages[found->second];
+	const auto first = out_values.size();
+	const auto status = decode_plans[found->second].decode(data, out_values);
+
+#if defined(DBC_ENABLE_METRICS)
+	if (status == Message::ParseSignalsStatus::Success) {
+		const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - decode_start).count();
+		Metrics::record_decoded(message_id, static_cast<uint64_t>(latency));
+	} else if (status == Message::ParseSignalsStatus::ErrorMessageToLong) {
+		Metrics::record_message_too_long();
+	}
+#endif
+
+	if (status == Message::ParseSignalsStatus::Success && !observers.empty()) {
+		DecodedMessage decoded{&message, found->second, out_values.data() + first, out_values.size() - first, timestamp_ns};
+		for (auto* observer : observers) {
+			observer->on_decoded(decoded);
 		}
 	}
-	return Message::ParseSignalsStatus::ErrorUnknownID;
+	return status;
+}
+
+void DbcParser::parse_batch(const Frame* frames, std::size_t count, BatchResult& result, BatchOrder order) {
+	const std::size_t unknown = messages.size();
+
+	// Counting sort on the message index, unknown ids get the last bucket
+	auto& offsets = result.group_offsets;
+	offsets.assign(unknown + 2, 0);
+	result.frames.resize(count);
+	for (std::size_t i = 0; i < count; i++) {
+		std::size_t message_index = DecodedFrame::npos;
+		auto found = message_id_index.find(frames[i].id);
+		if (found != message_id_index.end()) {
+			message_index = found->second;
+		}
+		result.frames[i] = DecodedFrame{i, message_index, Message::ParseSignalsStatus::ErrorUnknownID, 0, 0};
+		offsets[(message_index == DecodedFrame::npos ? unknown : message_index) + 1]++;
+	}
+	for (std::size_t bucket = 1; bucket < offsets.size(); bucket++) {
+		offsets[bucket] += offsets[bucket - 1];
+	}
+
+	// offsets[b] is now where bucket b starts. Scattering advances it to the end of the bucket,
+	// shifting by one afterwards turns the ends back into starts.
+	result.permutation.resize(count);
+	std::size_t total_values = 0;
+	for (std::size_t i = 0; i < count; i++) {
+		const auto message_index = result.frames[i].message_index;
+		result.permutation[offsets[message_index == DecodedFrame::npos ? unknown : message_index]++] = i;
+
+		if (order == BatchOrder::Original) {
+			result.frames[i].first_value = total_values;
+			total_values += message_index == DecodedFrame::npos ? 0 : decode_plans[message_index].signals().size();
+		}
+	}
+	for (std::size_t bucket = offsets.size() - 1; bucket > 0; bucket--) {
+		offsets[bucket] = offsets[bucket - 1];
+	}
+	offsets[0] = 0;
+
+	if (order == BatchOrder::Grouped) {
+		for (std::size_t msg = 0; msg < unknown; msg++) {
+			total_values += (offsets[msg + 1] - offsets[msg]) * decode_plans[msg].signals().size();
+		}
+	}
+	result.values.resize(total_values);
+	if (check_ranges) {
+		result.out_of_range.assign((total_values + 63) / 64, 0);
+	} else {
+		result.out_of_range.clear();
+	}
+
+	std::size_t next_value = 0;
+	for (std::size_t msg = 0; msg <= unknown; msg++) {
+		std::size_t message_index = DecodedFrame::npos;
+		if (msg != unknown) {
+			message_index = msg;
+		}
+
+		for (std::size_t position = offsets[msg]; position < offsets[msg + 1]; position++) {
+			const std::size_t frame_index = result.permutation[position];
+			auto& decoded = result.frames[order == BatchOrder::Grouped ? position : frame_index];
+			if (order == BatchOrder::Grouped) {
+				decoded = DecodedFrame{frame_index, message_index, Message::ParseSignalsStatus::ErrorUnknownID, next_value, 0};
+			}
+
+			if (msg == unknown) {
+				DBC_METRICS_ONLY(Metrics::record_unknown_id());
+				continue;
+			}
+
+			DBC_METRICS_ONLY(const auto decode_start = std::chrono::steady_clock::now());
+			const auto& plan = decode_plans[msg];
+			const auto& frame = frames[frame_index];
+			double* values = result.values.data() + decoded.first_value;
+			decoded.status = plan.decode(frame.data, frame.size, values);
+			if (order == BatchOrder::Grouped) {
+				next_value += plan.signals().size();
+			}
+
+#if defined(DBC_ENABLE_METRICS)
+			if (decoded.status == Message::ParseSignalsStatus::Success) {
+				const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - decode_start).count();
+				Metrics::record_decoded(frame.id, static_cast<uint64_t>(latency));
+			} else if (decoded.status == Message::ParseSignalsStatus::ErrorMessageToLong) {
+				Metrics::record_message_too_long();
+			}
+#endif
+
+			if (decoded.status != Message::ParseSignalsStatus::Success) {
+				continue;
+			}
+			decoded.value_count = plan.signals().size();
+
+			if (check_ranges) {
+				flag_out_of_range(plan, msg, values, decoded.first_value, result.out_of_range);
+			}
+
+			if (!observers.empty()) {
+				DecodedMessage message{&messages[msg], msg, values, decoded.value_count, frame.timestamp_ns};
+				for (auto* observer : observers) {
+					observer->on_decoded(message);
+				}
+			}
+		}
+	}
+}
+
+void DbcParser::parse_batch(const std::vector<Frame>& frames, BatchResult& result, BatchOrder order) {
+	parse_batch(frames.data(), frames.size(), result, order);
 }
 
-void DbcParser::parse_dbc_header(std::istream& file_stream) {
+static std::size_t lowest_set_bit(uint64_t value) {
+#if defined(__GNUC__)
+	return static_cast<std::size_t>(__builtin_ctzll(value));
+#else
+	std::size_t bit = 0;
+	while ((value & 1) == 0) {
+		value >>= 1;
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+void DbcParser::flag_out_of_range(const DecodePlan& plan, std::size_t message_index, const double* values, std::size_t first_value, std::vector<uint64_t>& flags) {
+	const std::size_t signal_count = plan.signals().size();
+	auto& counts = range_violation_counts[message_index];
+	for (std::size_t chunk = 0; chunk < signal_count; chunk += 64) {
+		uint64_t mask = plan.out_of_range(values + chunk, chunk, std::min<std::size_t>(64, signal_count - chunk));
+		if (mask == 0) {
+			continue;
+		}
+
+		// The chunk's bits can straddle two words of the flags
+		const std::size_t position = first_value + chunk;
+		const std::size_t shift = position % 64;
+		flags[position / 64] |= mask << shift;
+		if (shift != 0 && (mask >> (64 - shift)) != 0) {
+			flags[position / 64 + 1] |= mask >> (64 - shift);
+		}
+
+		for (; mask != 0; mask &= mask - 1) {
+			counts[chunk + lowest_set_bit(mask)]++;
+		}
+	}
+}
+
+void DbcParser::enable_range_check(bool enable) {
+	check_ranges = enable;
+}
+
+uint64_t DbcParser::range_violations(const SignalHandle& handle) const {
+	return range_violation_counts.at(handle.message_index).at(handle.signal_index);
+}
+
+void DbcParser::reset_range_violations() {
+	for (auto& counts : range_violation_counts) {
+		std::fill(counts.begin(), counts.end(), 0);
+	}
+}
+
+const std::vector<DecodePlan>& DbcParser::get_decode_plans() const {
+	return decode_plans;
+}
+
+void DbcParser::enable_fixed_point(bool enable) {
+	build_fixed_point = enable;
+}
+
+const std::vector<FixedPointPlan>& DbcParser::get_fixed_point_plans() const {
+	return fixed_point_plans;
+}
+
+std::vector<SignalHandle> DbcParser::inexact_fixed_point_signals() const {
+	std::vector<SignalHandle> inexact;
+	for (std::size_t msg = 0; msg < fixed_point_plans.size(); msg++) {
+		for (auto signal : fixed_point_plans[msg].inexact_signals()) {
+			inexact.push_back(SignalHandle{msg, signal});
+		}
+	}
+	return inexact;
+}
+
+std::vector<SignalHandle> DbcParser::unsupported_fixed_point_signals() const {
+	std::vector<SignalHandle> unsupported;
+	for (std::size_t msg = 0; msg < fixed_point_plans.size(); msg++) {
+		for (auto signal : fixed_point_plans[msg].unsupported_signals()) {
+			unsupported.push_back(SignalHandle{msg, signal});
+		}
+	}
+	return unsupported;
+}
+
+Message::ParseSignalsStatus DbcParser::parse_message_fixed(uint32_t message_id, const std::vector<uint8_t>& data, std::vector<int64_t>& out_values) const {
+	auto found = message_id_index.find(message_id);
+	if (found == message_id_index.end() || found->second >= fixed_point_plans.size()) {
+		return Message::ParseSignalsStatus::ErrorUnknownID;
+	}
+	return fixed_point_plans[found->second].decode(data, out_values);
+}
+
+void DbcParser::add_observer(DecodeObserver& observer) {
+	observers.push_back(&observer);
+}
+
+void DbcParser::remove_observer(DecodeObserver& observer) {
+	observers.erase(std::remove(observers.begin(), observers.end(), &observer), observers.end());
+}
+
+// Column of the first character on the line, where the expected keyword should start
+static std::size_t keyword_column(const std::string& line) {
+	const auto first = line.find_first_not_of(" \t");
+	return first == std::string::npos ? 1 : first + 1;
+}
+
+ParseResult DbcParser::parse_dbc_header(std::istream& file_stream, std::size_t& line_number) {
 	std::string line;
 	std::smatch match;
+	ParseResult result;
 
-	Utils::StreamHandler::get_line(file_stream, line);
+	Utils::StreamHandler::get_line(file_stream, line, &line_number);
 
 	if (!std::regex_search(line, match, version_re)) {
-		throw DbcFileIsMissingVersion(line);
+		result.error = ParseError::MissingVersion;
+		result.line = line_number == 0 ? 1 : line_number;
+		result.column = keyword_column(line);
+		result.context = line;
+		return result;
 	}
 
 	version = match.str(2);
 
-	Utils::StreamHandler::get_next_non_blank_line(file_stream, line);
-	Utils::StreamHandler::skip_to_next_blank_line(file_stream, line);
-	Utils::StreamHandler::get_next_non_blank_line(file_stream, line);
+	Utils::StreamHandler::get_next_non_blank_line(file_stream, line, &line_number);
+	Utils::StreamHandler::skip_to_next_blank_line(file_stream, line, &line_number);
+	Utils::StreamHandler::get_next_non_blank_line(file_stream, line, &line_number);
 
 	if (!std::regex_search(line, match, bit_timing_re)) {
-		throw DbcFileIsMissingBitTiming(line);
+		result.error = ParseError::MissingBitTiming;
+		result.line = line_number;
+		result.column = keyword_column(line);
+		result.context = line;
 	}
+	return result;
 }
 
-void DbcParser::parse_dbc_nodes(std::istream& file_stream) {
+void DbcParser::parse_dbc_nodes(std::istream& file_stream, std::size_t& line_number) {
 	std::string line;
 	std::smatch match;
 
-	Utils::StreamHandler::get_next_non_blank_line(file_stream, line);
+	Utils::StreamHandler::get_next_non_blank_line(file_stream, line, &line_number);
 
 	std::regex_search(line, match, node_re);
 
@@ -163,30 +637,59 @@ void DbcParser::parse_dbc_nodes(std::istream& file_stream) {
 	}
 }
 
-void DbcParser::parse_dbc_messages(const std::vector<std::string>& lines) {
+void DbcParser::add_unused_line(const std::string& line, const LinePosition& position, std::vector<std::string>& kept_lines) {
+	missed_line_count++;
+	if (unused_lines_policy == UnusedLines::Keep) {
+		kept_lines.push_back(line);
+	} else if (unused_lines_policy == UnusedLines::Positions) {
+		missed_line_positions.push_back(position);
+	}
+}
+
+void DbcParser::parse_dbc_messages(const std::vector<std::string>& lines, const std::vector<LinePosition>& positions) {
+	const auto messages_start = parse_clock_ns(collect_report);
 	std::smatch match;
 
 	std::vector<Value> signal_value;
+	std::vector<std::pair<uint32_t, uint32_t>> cycle_times;
+	bool has_default_cycle_time = false;
+	uint32_t default_cycle_time = 0;
+
+	// Messages and unused lines are built on the global heap and copied once into exactly sized
+	// vectors, so a MonotonicResource doesn't keep every reallocation and temporary around
+	std::vector<Message> parsed_messages;
+	std::vector<std::string> kept_lines;
+
+	bool metadata_continues = false;
+	for (std::size_t line_index = 0; line_index < lines.size(); line_index++) {
+		const auto& line = lines[line_index];
+
+		// Rest of a comment spanning several lines. A quote left open by mistake ends at the next statement.
+		if (metadata_continues) {
+			if (!Metadata::is_statement_start(line)) {
+				metadata_continues = database_metadata.append(line);
+				continue;
+			}
+			database_metadata.end_statement();
+			metadata_continues = false;
+		}
 
-	for (const auto& line : lines) {
 		if (std::regex_search(line, match, message_re)) {
-			uint32_t message_id = static_cast<uint32_t>(std::stoul(match.str(MESSAGE_ID_GROUP)));
+			uint32_t message_id = static_cast<uint32_t>(Utils::String::convert_to_unsigned(match.str(MESSAGE_ID_GROUP)));
 			std::string name = match.str(MESSAGE_NAME_GROUP);
-			uint8_t size = static_cast<uint8_t>(std::stoul(match.str(MESSAGE_SIZE_GROUP)));
-			std::string node = match.str(MESSAGE_NODE_GROUP);
-
-			Message msg(message_id, name, size, node);
+			uint8_t size = static_cast<uint8_t>(Utils::String::convert_to_unsigned(match.str(MESSAGE_SIZE_GROUP)));
+			InternedString node = string_pool.intern(match.str(MESSAGE_NODE_GROUP));
 
-			messages.push_back(msg);
+			parsed_messages.emplace_back(message_id, name, size, node);
 			continue;
 		}
 
-		if (std::regex_search(line, match, signal_re) && !messages.empty()) {
+		if (std::regex_search(line, match, signal_re) && !parsed_messages.empty()) {
 			std::string name = match.str(SIGNAL_NAME_GROUP);
 			bool is_multiplexed = false; // No support yet
-			uint32_t start_bit = static_cast<uint32_t>(std::stoul(match.str(SIGNAL_START_BIT_GROUP)));
-			uint32_t size = static_cast<uint32_t>(std::stoul(match.str(SIGNAL_SIZE_GROUP)));
-			bool is_bigendian = (std::stoul(match.str(SIGNAL_ENDIAN_GROUP)) == 0);
+			uint32_t start_bit = static_cast<uint32_t>(Utils::String::convert_to_unsigned(match.str(SIGNAL_START_BIT_GROUP)));
+			uint32_t size = static_cast<uint32_t>(Utils::String::convert_to_unsigned(match.str(SIGNAL_SIZE_GROUP)));
+			bool is_bigendian = (Utils::String::convert_to_unsigned(match.str(SIGNAL_ENDIAN_GROUP)) == 0);
 			bool is_signed = (match.str(SIGNAL_SIGNED_GROUP) == "-");
 
 			double factor = Utils::String::convert_to_double(match.str(SIGNAL_FACTOR_GROUP));
@@ -194,18 +697,24 @@ void DbcParser::parse_dbc_messages(const std::vector<std::string>& lines) {
 			double min = Utils::String::convert_to_double(match.str(SIGNAL_MIN_GROUP));
 			double max = Utils::String::convert_to_double(match.str(SIGNAL_MAX_GROUP));
 
-			std::string unit = match.str(SIGNAL_UNIT_GROUP);
+			InternedString unit = intern_group(match, SIGNAL_UNIT_GROUP);
 
-			std::vector<std::string> receivers;
-			Utils::String::split(match.str(SIGNAL_RECIEVER_GROUP), receivers, ',');
+			std::vector<InternedString> receivers;
+			const auto& receiver_group = match[SIGNAL_RECIEVER_GROUP];
+			if (receiver_group.matched) {
+				const char* first = line.data() + (receiver_group.first - line.begin());
+				Utils::String::for_each_token(first, first + receiver_group.length(), ',', [this, &receivers](const char* data, std::size_t length) {
+					receivers.push_back(string_pool.intern(data, length));
+				});
+			}
 
 			Signal sig(name, is_multiplexed, start_bit, size, is_bigendian, is_signed, factor, offset, min, max, unit, receivers);
-			messages.back().append_signal(sig);
+			parsed_messages.back().append_signal(sig);
 			continue;
 		}
 
-		if (std::regex_search(line, match, value_re) && !messages.empty()) {
-			uint32_t message_id = static_cast<uint32_t>(std::stoul(match.str(2)));
+		if (std::regex_search(line, match, value_re) && !parsed_messages.empty()) {
+			uint32_t message_id = static_cast<uint32_t>(Utils::String::convert_to_unsigned(match.str(2)));
 			std::string signal_name = match.str(3);
 
 			// Loop over the rest of the descriptions
@@ -218,7 +727,7 @@ void DbcParser::parse_dbc_messages(const std::vector<std::string>& lines) {
 			std::vector<Signal::ValueDescription> values{};
 			for (std::sregex_iterator i = desc_iter; i != desc_end; ++i) {
 				std::smatch desc_match = *desc_iter;
-				uint32_t number = static_cast<uint32_t>(std::stoul(desc_match.str(1)));
+				uint32_t number = static_cast<uint32_t>(Utils::String::convert_to_unsigned(desc_match.str(1)));
 				std::string text = desc_match.str(2);
 
 				values.push_back(Signal::ValueDescription{number, text});
@@ -231,23 +740,190 @@ void DbcParser::parse_dbc_messages(const std::vector<std::string>& lines) {
 			continue;
 		}
 
+		// Comments and attributes are kept as text until metadata() is first used, so they aren't unused lines
+		if (Metadata::is_metadata_line(line)) {
+			metadata_continues = database_metadata.append(line);
+			// Only the attribute lines need the extra regex
+			if (line.compare(0, 3, "BA_") != 0) {
+				continue;
+			}
+			if (std::regex_search(line, match, cycle_time_re)) {
+				cycle_times.emplace_back(static_cast<uint32_t>(Utils::String::convert_to_unsigned(match.str(1))), static_cast<uint32_t>(Utils::String::convert_to_unsigned(match.str(2))));
+			} else if (std::regex_search(line, match, cycle_time_default_re)) {
+				has_default_cycle_time = true;
+				default_cycle_time = static_cast<uint32_t>(Utils::String::convert_to_unsigned(match.str(1)));
+			}
+			continue;
+		}
+
 		if (line.length() > 0) {
-			missed_lines.push_back(line);
+			add_unused_line(line, positions[line_index], kept_lines);
 		}
 	}
 
+	messages.reserve(parsed_messages.size());
+	for (const auto& message : parsed_messages) {
+		messages.emplace_back(message, *memory_resource);
+	}
+	missed_lines.reserve(kept_lines.size());
+	for (auto& kept : kept_lines) {
+		missed_lines.push_back(std::move(kept));
+	}
+
+	const auto messages_done = parse_clock_ns(collect_report);
+	build_indexes();
+	const auto indexes_done = parse_clock_ns(collect_report);
+
+	std::string qualified_name;
 	for (const auto& signal : signal_value) {
-		for (auto& msg : messages) {
-			if (msg.id() == signal.can_id) {
-				msg.add_value_description(signal.signal_name, signal.value_descriptions);
-				break;
-			}
+		auto message = message_id_index.find(signal.can_id);
+		if (message == message_id_index.end()) {
+			continue;
+		}
+
+		auto& target = messages[message->second];
+		qualified_name = target.name();
+		qualified_name += '.';
+		qualified_name += signal.signal_name;
+		auto handle = signal_name_index.find(qualified_name);
+		if (handle != signal_name_index.end() && handle->second.message_index == message->second) {
+			target.add_value_description(handle->second.signal_index, signal.value_descriptions);
+		} else if (handle != signal_name_index.end()) {
+			// Another message with the same name owns the index entry, only then the signals are searched by name
+			target.add_value_description(signal.signal_name, signal.value_descriptions);
 		}
 	}
+
+	if (has_default_cycle_time) {
+		for (auto& message : messages) {
+			message.set_cycle_time(default_cycle_time);
+		}
+	}
+	for (const auto& cycle_time : cycle_times) {
+		auto message = message_id_index.find(cycle_time.first);
+		if (message != message_id_index.end()) {
+			messages[message->second].set_cycle_time(cycle_time.second);
+		}
+	}
+
+	if (collect_report) {
+		report.messages_ns = messages_done - messages_start;
+		report.indexes_ns = indexes_done - messages_done;
+		report.value_descriptions_ns = parse_clock_ns(collect_report) - indexes_done;
+	}
 }
 
-std::vector<std::string> DbcParser::unused_lines() const {
+void DbcParser::build_indexes() {
+	message_id_index.reserve(messages.size());
+	message_name_index.reserve(messages.size());
+	decode_plans.reserve(messages.size());
+
+	// emplace keeps the first definition when a file repeats an id or name
+	for (std::size_t msg = 0; msg < messages.size(); msg++) {
+		const auto& message = messages[msg];
+		message_id_index.emplace(message.id(), msg);
+		message_name_index.emplace(message.name(), msg);
+		decode_plans.emplace_back(message);
+		range_violation_counts.emplace_back(message.get_signals().size(), 0);
+		if (build_fixed_point) {
+			fixed_point_plans.emplace_back(message);
+		}
+
+		const auto& signals = message.get_signals();
+		for (std::size_t i = 0; i < signals.size(); i++) {
+			signal_name_index.emplace(message.name() + "." + signals[i].name, SignalHandle{msg, i});
+		}
+	}
+}
+
+InternedString DbcParser::intern_group(const std::smatch& match, unsigned group) {
+	const auto& sub_match = match[group];
+	if (!sub_match.matched || sub_match.length() == 0) {
+		return string_pool.intern(std::string());
+	}
+	return string_pool.intern(&*sub_match.first, static_cast<std::size_t>(sub_match.length()));
+}
+
+void DbcParser::set_unused_lines(UnusedLines policy) {
+	unused_lines_policy = policy;
+}
+
+const Vector<std::string>& DbcParser::unused_lines() const {
 	return missed_lines;
 }
 
+const std::vector<LinePosition>& DbcParser::unused_line_positions() const {
+	return missed_line_positions;
+}
+
+const Metadata& DbcParser::metadata() const {
+	return database_metadata;
+}
+
+void DbcParser::enable_parse_report(bool enable) {
+	collect_report = enable;
+}
+
+const ParseReport& DbcParser::get_parse_report() const {
+	return report;
+}
+
+static std::size_t string_heap_bytes(const std::string& str) {
+	// Short strings live inside the object itself
+	const char* object = reinterpret_cast<const char*>(&str);
+	if (str.data() >= object && str.data() < object + sizeof(std::string)) {
+		return 0;
+	}
+	return str.capacity() + 1;
+}
+
+template<class Map>
+static std::size_t hash_index_bytes(const Map& map) {
+	return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void*));
+}
+
+void DbcParser::account_memory() {
+	report.message_bytes = messages.capacity() * sizeof(Message);
+	report.string_bytes = string_pool.memory_bytes() + version.capacity() + nodes.capacity() * sizeof(std::string);
+	for (const auto& node : nodes) {
+		report.string_bytes += string_heap_bytes(node);
+	}
+	for (const auto& line : missed_lines) {
+		report.string_bytes += sizeof(std::string) + string_heap_bytes(line);
+	}
+	report.string_bytes += missed_line_positions.capacity() * sizeof(LinePosition) + database_metadata.memory_bytes();
+
+	for (const auto& message : messages) {
+		report.string_bytes += string_heap_bytes(message.name());
+
+		const auto& signals = message.get_signals();
+		report.signal_bytes += signals.capacity() * sizeof(Signal);
+		for (const auto& signal : signals) {
+			report.string_bytes += string_heap_bytes(signal.name);
+			report.signal_bytes += signal.receivers.capacity() * sizeof(InternedString);
+
+			report.value_description_bytes += signal.value_descriptions.capacity() * sizeof(Signal::ValueDescription);
+			for (const auto& description : signal.value_descriptions) {
+				report.value_description_bytes += string_heap_bytes(description.description);
+			}
+		}
+	}
+
+	report.index_bytes = hash_index_bytes(message_id_index) + hash_index_bytes(message_name_index) + hash_index_bytes(signal_name_index);
+	report.index_bytes += decode_plans.capacity() * sizeof(DecodePlan);
+	for (const auto& plan : decode_plans) {
+		report.index_bytes += plan.signals().capacity() * sizeof(SignalPlan);
+	}
+	report.index_bytes += fixed_point_plans.capacity() * sizeof(FixedPointPlan);
+	for (const auto& plan : fixed_point_plans) {
+		report.index_bytes += plan.signals().capacity() * sizeof(SignalPlan) + plan.scales().capacity() * sizeof(FixedPointScale);
+	}
+	for (const auto& entry : message_name_index) {
+		report.index_bytes += string_heap_bytes(entry.first);
+	}
+	for (const auto& entry : signal_name_index) {
+		report.index_bytes += string_heap_bytes(entry.first);
+	}
+}
+
 }
@@ -0,0 +1,503 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/message.hpp>
+#include <libdbc/signal.hpp>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Libdbc {
+
+constexpr unsigned ONE_BYTE = 8;
+constexpr unsigned TWO_BYTES = 16;
+constexpr unsigned FOUR_BYTES = 32;
+constexpr unsigned EIGHT_BYTES = 64;
+
+constexpr unsigned SEVEN_BITS = 7;
+
+static uint64_t low_bits_mask(uint32_t size) {
+	return size >= EIGHT_BYTES ? ~0ULL : ((1ULL << size) - 1);
+}
+
+static uint16_t byte_swap(uint16_t value) {
+#if defined(__GNUC__)
+	return __builtin_bswap16(value);
+#else
+	return static_cast<uint16_t>((value >> ONE_BYTE) | (value << ONE_BYTE));
+#endif
+}
+
+static uint32_t byte_swap(uint32_t value) {
+#if defined(__GNUC__)
+	return __builtin_bswap32(value);
+#else
+	return (value >> 24) | ((value >> ONE_BYTE) & 0xFF00U) | ((value << ONE_BYTE) & 0xFF0000U) | (value << 24);
+#endif
+}
+
+// Unaligned load of a little endian (Intel) or big endian (Motorola) field
+template<class T>
+static T load_little_endian(const uint8_t* data) {
+	T value;
+	std::memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	value = byte_swap(value);
+#endif
+	return value;
+}
+
+template<class T>
+static T load_big_endian(const uint8_t* data) {
+	T value;
+	std::memcpy(&value, data, sizeof(value));
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	value = byte_swap(value);
+#endif
+	return value;
+}
+
+template<class T>
+static void store_little_endian(T value, uint8_t* data) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	value = byte_swap(value);
+#endif
+	std::memcpy(data, &value, sizeof(value));
+}
+
+template<class T>
+static void store_big_endian(T value, uint8_t* data) {
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	value = byte_swap(value);
+#endif
+	std::memcpy(data, &value, sizeof(value));
+}
+
+// Replaces count bits of a byte starting at shift
+static void write_bits(uint8_t& byte, unsigned shift, unsigned count, uint64_t bits) {
+	const unsigned mask = ((1U << count) - 1) << shift;
+	byte = static_cast<uint8_t>((byte & ~mask) | ((static_cast<unsigned>(bits) << shift) & mask));
+}
+
+// Motorola bit numbering counted from the most significant bit of byte 0
+static uint32_t big_endian_position(uint32_t start_bit) {
+	return ONE_BYTE * (start_bit / ONE_BYTE) + (SEVEN_BITS - (start_bit % ONE_BYTE));
+}
+
+template<class Signed, class Unsigned>
+static double to_double(Unsigned raw_value, bool is_signed) {
+	return is_signed ? static_cast<double>(static_cast<Signed>(raw_value)) : static_cast<double>(raw_value);
+}
+
+static uint64_t raw_bits(const PayloadWords& words, uint32_t start_bit, uint32_t size, bool is_bigendian) {
+	if (is_bigendian) {
+		uint32_t msb_start = big_endian_position(start_bit); // Calculation taken from python CAN
+		uint64_t value = words.big_endian << msb_start;
+		return value >> (words.length_bits - size);
+	}
+	return words.little_endian >> start_bit;
+}
+
+static double physical_value(uint64_t raw_value, uint32_t size, bool is_signed, double factor, double offset) {
+	if (is_signed && size > 1) {
+		switch (size) {
+		case ONE_BYTE:
+			return static_cast<int8_t>(raw_value) * factor + offset;
+		case TWO_BYTES:
+			return static_cast<int16_t>(raw_value) * factor + offset;
+		case FOUR_BYTES:
+			return static_cast<int32_t>(raw_value) * factor + offset;
+		case EIGHT_BYTES:
+			return static_cast<double>(static_cast<int64_t>(raw_value)) * factor + offset;
+		default: {
+			// 2 complement -> decimal
+			const bool is_negative = (raw_value & (1ULL << (size - 1))) != 0;
+			int64_t native_int = 0;
+			if (is_negative) {
+				native_int = static_cast<int64_t>(raw_value | ~low_bits_mask(size)); // invert all bits above size
+			} else {
+				native_int = static_cast<int64_t>(raw_value & low_bits_mask(size)); // masking
+			}
+			return static_cast<double>(native_int) * factor + offset;
+		}
+		}
+	}
+
+	// use only the relevant bits
+	return static_cast<double>(raw_value & low_bits_mask(size)) * factor + offset;
+}
+
+static SignalPlan::Layout classify(const Signal& signal) {
+	// Motorola start bits name the most significant bit, an aligned field starts at bit 7 of its first byte
+	const uint32_t aligned_bit = signal.is_bigendian ? SEVEN_BITS : 0;
+	if (signal.start_bit % ONE_BYTE != aligned_bit) {
+		return SignalPlan::Layout::Generic;
+	}
+
+	switch (signal.size) {
+	case ONE_BYTE:
+		return SignalPlan::Layout::Byte;
+	case TWO_BYTES:
+		return signal.is_bigendian ? SignalPlan::Layout::BigEndian16 : SignalPlan::Layout::LittleEndian16;
+	case FOUR_BYTES:
+		return signal.is_bigendian ? SignalPlan::Layout::BigEndian32 : SignalPlan::Layout::LittleEndian32;
+	default:
+		return SignalPlan::Layout::Generic;
+	}
+}
+
+PayloadWords PayloadWords::load(const uint8_t* data, std::size_t size) {
+	PayloadWords words{0, 0, size * ONE_BYTE};
+	for (std::size_t i = 0; i < size; i++) {
+		words.little_endian |= static_cast<uint64_t>(data[i]) << i * ONE_BYTE;
+		words.big_endian = (words.big_endian << ONE_BYTE) | static_cast<uint64_t>(data[i]);
+	}
+	// TODO: does this also work on a big endian machine?
+	return words;
+}
+
+Payload::Payload(const uint8_t* data, std::size_t size)
+	: m_data(data)
+	, m_size(size)
+	, m_loaded(false)
+	, m_words{0, 0, 0} {
+}
+
+const uint8_t* Payload::data() const {
+	return m_data;
+}
+
+std::size_t Payload::size() const {
+	return m_size;
+}
+
+const PayloadWords& Payload::words() {
+	if (!m_loaded) {
+		m_words = PayloadWords::load(m_data, m_size);
+		m_loaded = true;
+	}
+	return m_words;
+}
+
+SignalPlan::SignalPlan(const Signal& signal, std::size_t signal_index)
+	: signal_index(signal_index)
+	, layout(classify(signal))
+	, first_byte(signal.start_bit / ONE_BYTE)
+	, byte_count(layout == Layout::Generic ? 0 : signal.size / ONE_BYTE)
+	, start_bit(signal.start_bit)
+	, size(signal.size)
+	, is_bigendian(signal.is_bigendian)
+	, is_signed(signal.is_signed)
+	, factor(signal.factor)
+	, offset(signal.offset)
+	, min(-std::numeric_limits<double>::infinity())
+	, max(std::numeric_limits<double>::infinity()) {
+	// Most files write [0|0] for "no range". The limits are widened a little so a value sitting
+	// exactly on one doesn't trip the check through rounding in factor and offset.
+	if (signal.max > signal.min) {
+		const double margin = 1e-9 * std::max(std::fabs(signal.min), std::fabs(signal.max));
+		min = signal.min - margin;
+		max = signal.max + margin;
+	}
+}
+
+uint64_t SignalPlan::raw(const PayloadWords& words) const {
+	return raw_bits(words, start_bit, size, is_bigendian);
+}
+
+int64_t SignalPlan::integer(uint64_t raw_value) const {
+	const uint64_t bits = raw_value & low_bits_mask(size);
+	if (is_signed && size > 1 && size < EIGHT_BYTES && (bits & (1ULL << (size - 1))) != 0) {
+		return static_cast<int64_t>(bits | ~low_bits_mask(size)); // invert all bits above size
+	}
+	return static_cast<int64_t>(bits);
+}
+
+double SignalPlan::physical(uint64_t raw_value) const {
+	return physical_value(raw_value, size, is_signed, factor, offset);
+}
+
+double decode_signal(const Signal& signal, const PayloadWords& words) {
+	return physical_value(raw_bits(words, signal.start_bit, signal.size, signal.is_bigendian), signal.size, signal.is_signed, signal.factor, signal.offset);
+}
+
+double SignalPlan::decode(const PayloadWords& words) const {
+	return physical(raw(words));
+}
+
+double SignalPlan::decode_aligned(const uint8_t* data) const {
+	// The loaded width already matches the signal, so signedness is a cast and no masking is needed
+	data += first_byte;
+	double value = 0;
+	switch (layout) {
+	case Layout::Byte:
+		value = to_double<int8_t>(*data, is_signed);
+		break;
+	case Layout::LittleEndian16:
+		value = to_double<int16_t>(load_little_endian<uint16_t>(data), is_signed);
+		break;
+	case Layout::LittleEndian32:
+		value = to_double<int32_t>(load_little_endian<uint32_t>(data), is_signed);
+		break;
+	case Layout::BigEndian16:
+		value = to_double<int16_t>(load_big_endian<uint16_t>(data), is_signed);
+		break;
+	case Layout::BigEndian32:
+		value = to_double<int32_t>(load_big_endian<uint32_t>(data), is_signed);
+		break;
+	case Layout::Generic:
+		break;
+	}
+	return value * factor + offset;
+}
+
+double SignalPlan::decode(Payload& payload) const {
+	// Short frames fall back to the generic path, which reads missing bytes as zero
+	if (layout != Layout::Generic && first_byte + byte_count <= payload.size()) {
+		return decode_aligned(payload.data());
+	}
+	return decode(payload.words());
+}
+
+uint64_t SignalPlan::extract(const uint8_t* data, std::size_t data_size) const {
+	if (layout != Layout::Generic && first_byte + byte_count <= data_size) {
+		switch (layout) {
+		case Layout::Byte:
+			return data[first_byte];
+		case Layout::LittleEndian16:
+			return load_little_endian<uint16_t>(data + first_byte);
+		case Layout::LittleEndian32:
+			return load_little_endian<uint32_t>(data + first_byte);
+		case Layout::BigEndian16:
+			return load_big_endian<uint16_t>(data + first_byte);
+		case Layout::BigEndian32:
+			return load_big_endian<uint32_t>(data + first_byte);
+		case Layout::Generic:
+			break;
+		}
+	}
+
+	// The reverse of insert, one byte at a time starting with the least significant bits
+	uint64_t raw_value = 0;
+	uint32_t done = 0;
+	if (is_bigendian) {
+		uint32_t end = big_endian_position(start_bit) + size;
+		while (done < size) {
+			const uint32_t last = end - 1;
+			const unsigned count = std::min<unsigned>(last % ONE_BYTE + 1, size - done);
+			const std::size_t index = last / ONE_BYTE;
+			const unsigned byte = index < data_size ? data[index] : 0;
+			raw_value |= static_cast<uint64_t>((byte >> (SEVEN_BITS - last % ONE_BYTE)) & ((1U << count) - 1)) << done;
+			end -= count;
+			done += count;
+		}
+		return raw_value;
+	}
+
+	uint32_t position = start_bit;
+	while (done < size) {
+		const unsigned count = std::min<unsigned>(ONE_BYTE - position % ONE_BYTE, size - done);
+		const std::size_t index = position / ONE_BYTE;
+		const unsigned byte = index < data_size ? data[index] : 0;
+		raw_value |= static_cast<uint64_t>((byte >> (position % ONE_BYTE)) & ((1U << count) - 1)) << done;
+		position += count;
+		done += count;
+	}
+	return raw_value;
+}
+
+std::size_t SignalPlan::end_byte() const {
+	const uint32_t first_bit = is_bigendian ? big_endian_position(start_bit) : start_bit;
+	return (first_bit + size + SEVEN_BITS) / ONE_BYTE;
+}
+
+uint64_t SignalPlan::raw_from_physical(double value) const {
+	const double scaled = std::round(factor != 0 ? (value - offset) / factor : 0);
+	if (size == 0 || std::isnan(scaled)) {
+		return 0;
+	}
+
+	if (is_signed) {
+		const int64_t lowest = size >= EIGHT_BYTES ? std::numeric_limits<int64_t>::min() : -(int64_t(1) << (size - 1));
+		const int64_t highest = size >= EIGHT_BYTES ? std::numeric_limits<int64_t>::max() : (int64_t(1) << (size - 1)) - 1;
+		int64_t clamped = 0;
+		if (scaled <= static_cast<double>(lowest)) {
+			clamped = lowest;
+		} else if (scaled >= static_cast<double>(highest)) {
+			clamped = highest;
+		} else {
+			clamped = static_cast<int64_t>(scaled);
+		}
+		return static_cast<uint64_t>(clamped) & low_bits_mask(size);
+	}
+
+	const uint64_t highest = low_bits_mask(size);
+	if (scaled <= 0) {
+		return 0;
+	}
+	if (scaled >= static_cast<double>(highest)) {
+		return highest;
+	}
+	return static_cast<uint64_t>(scaled);
+}
+
+void SignalPlan::insert(uint64_t raw_value, uint8_t* data) const {
+	switch (layout) {
+	case Layout::Byte:
+		data[first_byte] = static_cast<uint8_t>(raw_value);
+		return;
+	case Layout::LittleEndian16:
+		store_little_endian(static_cast<uint16_t>(raw_value), data + first_byte);
+		return;
+	case Layout::LittleEndian32:
+		store_little_endian(static_cast<uint32_t>(raw_value), data + first_byte);
+		return;
+	case Layout::BigEndian16:
+		store_big_endian(static_cast<uint16_t>(raw_value), data + first_byte);
+		return;
+	case Layout::BigEndian32:
+		store_big_endian(static_cast<uint32_t>(raw_value), data + first_byte);
+		return;
+	case Layout::Generic:
+		break;
+	}
+
+	// One byte at a time, starting with the least significant bits of the value
+	uint32_t remaining = size;
+	if (is_bigendian) {
+		uint32_t end = big_endian_position(start_bit) + size; // one past the least significant bit
+		while (remaining > 0) {
+			const uint32_t last = end - 1;
+			const unsigned count = std::min<unsigned>(last % ONE_BYTE + 1, remaining);
+			write_bits(data[last / ONE_BYTE], SEVEN_BITS - last % ONE_BYTE, count, raw_value);
+			raw_value >>= count;
+			end -= count;
+			remaining -= count;
+		}
+		return;
+	}
+
+	uint32_t position = start_bit;
+	while (remaining > 0) {
+		const unsigned count = std::min<unsigned>(ONE_BYTE - position % ONE_BYTE, remaining);
+		write_bits(data[position / ONE_BYTE], position % ONE_BYTE, count, raw_value);
+		raw_value >>= count;
+		position += count;
+		remaining -= count;
+	}
+}
+
+void SignalPlan::encode(double value, uint8_t* data) const {
+	insert(raw_from_physical(value), data);
+}
+
+DecodePlan::DecodePlan(const Message& message)
+	: m_id(message.id()) {
+	const auto& signals = message.get_signals();
+	m_signals.reserve(signals.size());
+	for (std::size_t i = 0; i < signals.size(); i++) {
+		m_signals.push_back(SignalPlan(signals[i], i));
+	}
+	classify_signals();
+}
+
+DecodePlan::DecodePlan(const Message& message, const std::vector<std::size_t>& signal_indices)
+	: m_id(message.id()) {
+	const auto& signals = message.get_signals();
+	m_signals.reserve(signal_indices.size());
+	for (auto index : signal_indices) {
+		m_signals.push_back(SignalPlan(signals.at(index), index));
+	}
+	classify_signals();
+}
+
+void DecodePlan::classify_signals() {
+	m_aligned_size = 0;
+	m_has_generic = false;
+	m_min.clear();
+	m_max.clear();
+	for (const auto& signal : m_signals) {
+		m_min.push_back(signal.min);
+		m_max.push_back(signal.max);
+
+		if (signal.layout == SignalPlan::Layout::Generic) {
+			m_has_generic = true;
+		} else if (signal.first_byte + signal.byte_count > m_aligned_size) {
+			m_aligned_size = signal.first_byte + signal.byte_count;
+		}
+	}
+}
+
+uint32_t DecodePlan::id() const {
+	return m_id;
+}
+
+const std::vector<SignalPlan>& DecodePlan::signals() const {
+	return m_signals;
+}
+
+Message::ParseSignalsStatus DecodePlan::decode(const std::vector<uint8_t>& data, std::vector<double>& values) const {
+	const auto first = values.size();
+	values.resize(first + m_signals.size());
+	const auto status = decode(data.data(), data.size(), values.data() + first);
+	if (status != Message::ParseSignalsStatus::Success) {
+		values.resize(first);
+	}
+	return status;
+}
+
+Message::ParseSignalsStatus DecodePlan::decode(const uint8_t* data, std::size_t size, double* values) const {
+	if (size > ONE_BYTE) {
+		return Message::ParseSignalsStatus::ErrorMessageToLong; // not supported yet
+	}
+
+	if (size < m_aligned_size) {
+		// Short frame, the generic path reads the missing bytes as zero
+		const auto words = PayloadWords::load(data, size);
+		for (const auto& signal : m_signals) {
+			*values++ = signal.decode(words);
+		}
+		return Message::ParseSignalsStatus::Success;
+	}
+
+	PayloadWords words{0, 0, 0};
+	if (m_has_generic) {
+		words = PayloadWords::load(data, size);
+	}
+	for (const auto& signal : m_signals) {
+		*values++ = signal.layout == SignalPlan::Layout::Generic ? signal.decode(words) : signal.decode_aligned(data);
+	}
+	return Message::ParseSignalsStatus::Success;
+}
+
+void DecodePlan::decode_extended(const uint8_t* data, std::size_t size, double* values) const {
+	for (const auto& signal : m_signals) {
+		*values++ = signal.physical(signal.extract(data, size));
+	}
+}
+
+uint64_t DecodePlan::out_of_range(const double* values, std::size_t first, std::size_t count) const {
+	const double* min = m_min.data() + first;
+	const double* max = m_max.data() + first;
+	uint64_t mask = 0;
+	std::size_t i = 0;
+#if defined(__SSE2__)
+	for (; i + 2 <= count; i += 2) {
+		const __m128d value = _mm_loadu_pd(values + i);
+		const __m128d outside = _mm_or_pd(_mm_cmplt_pd(value, _mm_loadu_pd(min + i)), _mm_cmpgt_pd(value, _mm_loadu_pd(max + i)));
+		mask |= static_cast<uint64_t>(_mm_movemask_pd(outside)) << i;
+	}
+#endif
+	for (; i < count; i++) {
+		mask |= static_cast<uint64_t>((values[i] < min[i]) | (values[i] > max[i])) << i;
+	}
+	return mask;
+}
+
+}
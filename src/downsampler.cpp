@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_observer.hpp>
+#include <libdbc/downsampler.hpp>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Libdbc {
+
+constexpr std::size_t Downsampler::npos;
+
+// Signed distance between two timestamps, logs aren't always in order
+static double elapsed_ns(uint64_t from, uint64_t to) {
+	return static_cast<double>(static_cast<int64_t>(to - from));
+}
+
+Downsampler::Downsampler(const DbcParser& parser, Callback callback)
+	: m_parser(parser)
+	, m_callback(std::move(callback)) {
+	std::size_t signals = 0;
+	for (const auto& message : parser.get_messages()) {
+		m_message_offsets.push_back(signals);
+		signals += message.get_signals().size();
+	}
+	m_track_by_signal.assign(signals, npos);
+}
+
+bool Downsampler::add_signal(const std::string& qualified_name, const DownsampleConfig& config) {
+	return add_signal(m_parser.find_signal_handle(qualified_name), config);
+}
+
+bool Downsampler::add_signal(const SignalHandle& handle, const DownsampleConfig& config) {
+	if (!handle.is_valid() || handle.message_index >= m_message_offsets.size()) {
+		return false;
+	}
+
+	// A signal index past the message's end would land on the next message's slots
+	const auto first = m_message_offsets[handle.message_index];
+	const auto last = (handle.message_index + 1 < m_message_offsets.size()) ? m_message_offsets[handle.message_index + 1] : m_track_by_signal.size();
+	if (handle.signal_index >= last - first) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const auto slot = first + handle.signal_index;
+	if (m_track_by_signal[slot] == npos) {
+		m_track_by_signal[slot] = m_tracks.size();
+		m_tracks.push_back(Track());
+	}
+
+	auto& track = m_tracks[m_track_by_signal[slot]];
+	track = Track();
+	track.handle = handle;
+	track.config = config;
+	track.config.bucket_ns = std::max<uint64_t>(config.bucket_ns, 1);
+	track.config.max_points = std::max<std::size_t>(config.max_points, 2);
+	track.current.open = false;
+	track.pending.open = false;
+	track.stride = 1;
+	track.skipped = 0;
+	track.has_selected = false;
+	if (config.mode == DownsampleMode::Lttb) {
+		track.candidates.reserve(track.config.max_points);
+		track.pending_candidates.reserve(track.config.max_points);
+	}
+	return true;
+}
+
+std::size_t Downsampler::add_signals(const std::string& pattern, const DownsampleConfig& config) {
+	std::size_t added = 0;
+	for (const auto& handle : m_parser.search_signals(pattern)) {
+		added += add_signal(handle, config) ? 1 : 0;
+	}
+	return added;
+}
+
+void Downsampler::on_decoded(const DecodedMessage& decoded) {
+	if (decoded.message_index >= m_message_offsets.size()) {
+		return;
+	}
+
+	std::vector<DownsampledBucket> ready;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const auto first = m_message_offsets[decoded.message_index];
+		const auto last = (decoded.message_index + 1 < m_message_offsets.size()) ? m_message_offsets[decoded.message_index + 1] : m_track_by_signal.size();
+		const auto count = std::min(last - first, decoded.value_count);
+		for (std::size_t i = 0; i < count; i++) {
+			const auto track = m_track_by_signal[first + i];
+			if (track != npos) {
+				add(m_tracks[track], decoded.timestamp_ns, decoded.values[i]);
+			}
+		}
+		if (m_ready.empty()) {
+			return;
+		}
+		ready.swap(m_ready);
+	}
+
+	for (const auto& bucket : ready) {
+		m_callback(bucket);
+	}
+}
+
+void Downsampler::flush() {
+	std::vector<DownsampledBucket> ready;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& track : m_tracks) {
+			close_current(track);
+			emit_pending(track, nullptr);
+		}
+		ready.swap(m_ready);
+	}
+
+	for (const auto& bucket : ready) {
+		m_callback(bucket);
+	}
+}
+
+std::size_t Downsampler::signal_count() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_tracks.size();
+}
+
+void Downsampler::add(Track& track, uint64_t timestamp_ns, double value) {
+	const uint64_t index = timestamp_ns / track.config.bucket_ns;
+	auto& acc = track.current;
+	if (acc.open && index != acc.index) {
+		close_current(track);
+	}
+
+	const double offset = static_cast<double>(timestamp_ns - index * track.config.bucket_ns);
+	if (!acc.open) {
+		acc = Accumulator{true, index, 1, value, value, value, value, value, offset, timestamp_ns};
+	} else {
+		acc.count++;
+		acc.last = value;
+		acc.min = std::min(acc.min, value);
+		acc.max = std::max(acc.max, value);
+		acc.sum += value;
+		acc.time_sum += offset;
+		acc.last_ns = timestamp_ns;
+	}
+
+	if (track.config.mode != DownsampleMode::Lttb) {
+		return;
+	}
+	if (++track.skipped < track.stride) {
+		return;
+	}
+	track.skipped = 0;
+	if (track.candidates.size() == track.config.max_points) {
+		// Halve the resolution instead of growing, the first candidate is kept
+		std::size_t kept = 0;
+		for (std::size_t i = 0; i < track.candidates.size(); i += 2) {
+			track.candidates[kept++] = track.candidates[i];
+		}
+		track.candidates.resize(kept);
+		track.stride *= 2;
+	}
+	track.candidates.push_back(Point{timestamp_ns, value});
+}
+
+void Downsampler::close_current(Track& track) {
+	if (!track.current.open) {
+		return;
+	}
+
+	if (track.config.mode != DownsampleMode::Lttb) {
+		m_ready.push_back(summary(track, track.current));
+	} else {
+		emit_pending(track, &track.current);
+		track.pending = track.current;
+		track.pending_candidates.swap(track.candidates);
+		track.candidates.clear();
+		track.stride = 1;
+		track.skipped = 0;
+	}
+	track.current.open = false;
+}
+
+void Downsampler::emit_pending(Track& track, const Accumulator* next) {
+	auto& pending = track.pending;
+	if (!pending.open) {
+		return;
+	}
+
+	auto bucket = summary(track, pending);
+	const auto& candidates = track.pending_candidates;
+	if (!track.has_selected) {
+		// The series starts with its first sample
+		bucket.point_ns = candidates.front().timestamp_ns;
+		bucket.point_value = candidates.front().value;
+	} else if (next != nullptr) {
+		// Largest triangle between the previously selected sample and the mean of the next bucket
+		const auto& a = track.selected;
+		const double next_time = elapsed_ns(a.timestamp_ns, next->index * track.config.bucket_ns) + next->time_sum / static_cast<double>(next->count);
+		const double next_value = next->sum / static_cast<double>(next->count);
+		double best_area = -1;
+		for (const auto& point : candidates) {
+			const double time = elapsed_ns(a.timestamp_ns, point.timestamp_ns);
+			const double area = std::fabs(time * (next_value - a.value) - next_time * (point.value - a.value));
+			if (area > best_area) {
+				best_area = area;
+				bucket.point_ns = point.timestamp_ns;
+				bucket.point_value = point.value;
+			}
+		}
+	}
+	// Without a next bucket the series ends with its last sample, which summary() already picked
+
+	track.selected = Point{bucket.point_ns, bucket.point_value};
+	track.has_selected = true;
+	m_ready.push_back(bucket);
+	pending.open = false;
+}
+
+DownsampledBucket Downsampler::summary(const Track& track, const Accumulator& acc) const {
+	return DownsampledBucket{track.handle,
+							 acc.index * track.config.bucket_ns,
+							 acc.count,
+							 acc.first,
+							 acc.last,
+							 acc.min,
+							 acc.max,
+							 acc.sum / static_cast<double>(acc.count),
+							 acc.last_ns,
+							 acc.last};
+}
+
+}
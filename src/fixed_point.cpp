@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/fixed_point.hpp>
+#include <libdbc/message.hpp>
+#include <libdbc/signal.hpp>
+#include <limits>
+#include <vector>
+
+namespace Libdbc {
+
+constexpr int MAX_DECIMAL_DIGITS = 9;
+constexpr int MAX_BINARY_DIGITS = 32;
+constexpr double EXACT_INTEGER_LIMIT = 9007199254740992.0; // 2^53
+constexpr double SCALED_LIMIT = 4611686018427387904.0; // 2^62, leaves headroom below INT64_MAX
+
+struct Fraction {
+	int64_t numerator;
+	int64_t denominator;
+};
+
+// Powers of ten and two in increasing order, the candidate denominators
+static const std::vector<int64_t>& denominators() {
+	static const std::vector<int64_t> values = []() {
+		std::vector<int64_t> result;
+		int64_t power = 1;
+		for (int digit = 0; digit <= MAX_DECIMAL_DIGITS; digit++, power *= 10) {
+			result.push_back(power);
+		}
+		for (int digit = 1; digit <= MAX_BINARY_DIGITS; digit++) {
+			result.push_back(int64_t(1) << digit);
+		}
+		std::sort(result.begin(), result.end());
+		result.erase(std::unique(result.begin(), result.end()), result.end());
+		return result;
+	}();
+	return values;
+}
+
+static bool exact_fraction(double value, Fraction& fraction) {
+	for (auto denominator : denominators()) {
+		const double scaled = value * static_cast<double>(denominator);
+		if (std::fabs(scaled) >= EXACT_INTEGER_LIMIT) {
+			return false;
+		}
+
+		const auto numerator = static_cast<int64_t>(std::llround(scaled));
+		if (static_cast<double>(numerator) / static_cast<double>(denominator) == value) {
+			fraction = Fraction{numerator, denominator};
+			return true;
+		}
+	}
+	return false;
+}
+
+static int64_t gcd(int64_t a, int64_t b) {
+	while (b != 0) {
+		const int64_t rest = a % b;
+		a = b;
+		b = rest;
+	}
+	return a;
+}
+
+// value * multiplier + addend in integers, false when the exact result doesn't fit int64_t
+static bool multiply_add(int64_t value, int64_t multiplier, int64_t addend, int64_t& result) {
+	const int64_t highest = std::numeric_limits<int64_t>::max();
+	const int64_t lowest = std::numeric_limits<int64_t>::min();
+	if (value > 0 ? (multiplier > 0 ? value > highest / multiplier : multiplier < lowest / value)
+				  : (multiplier > 0 ? value < lowest / multiplier : value != 0 && multiplier < highest / value)) {
+		return false;
+	}
+	const int64_t product = value * multiplier;
+	if ((addend > 0 && product > highest - addend) || (addend < 0 && product < lowest - addend)) {
+		return false;
+	}
+	result = product + addend;
+	return true;
+}
+
+// True when every raw value the signal can produce scales without leaving int64_t. The scaling is linear, so both ends of the raw range are enough.
+static bool fits(const Signal& signal, int64_t multiplier, int64_t addend) {
+	int64_t lowest = 0;
+	int64_t highest = 0;
+	if (signal.is_signed && signal.size > 1) {
+		const uint32_t bits = std::min<uint32_t>(signal.size, 64);
+		lowest = static_cast<int64_t>(~uint64_t(0) << (bits - 1));
+		highest = static_cast<int64_t>((uint64_t(1) << (bits - 1)) - 1);
+	} else if (signal.size >= 64) {
+		return false; // raw values above INT64_MAX
+	} else {
+		highest = static_cast<int64_t>((uint64_t(1) << signal.size) - 1);
+	}
+	int64_t scaled = 0;
+	return multiply_add(lowest, multiplier, addend, scaled) && multiply_add(highest, multiplier, addend, scaled);
+}
+
+FixedPointScale FixedPointScale::from_signal(const Signal& signal) {
+	// Plain integers like counters are the raw value itself, at any width
+	if (signal.factor == 1 && signal.offset == 0) {
+		return FixedPointScale{1, 0, 1, true, true};
+	}
+
+	Fraction factor{0, 1};
+	Fraction offset{0, 1};
+	if (exact_fraction(signal.factor, factor) && exact_fraction(signal.offset, offset)) {
+		const int64_t denominator = factor.denominator / gcd(factor.denominator, offset.denominator) * offset.denominator;
+		const int64_t multiplier = factor.numerator * (denominator / factor.denominator);
+		const int64_t addend = offset.numerator * (denominator / offset.denominator);
+		const bool no_overflow = std::fabs(static_cast<double>(factor.numerator) * static_cast<double>(denominator / factor.denominator)) < SCALED_LIMIT
+			&& std::fabs(static_cast<double>(offset.numerator) * static_cast<double>(denominator / offset.denominator)) < SCALED_LIMIT;
+		if (no_overflow && fits(signal, multiplier, addend)) {
+			return FixedPointScale{multiplier, addend, denominator, true, true};
+		}
+	}
+
+	// Closest Q-format that still fits, starting from the finest one
+	for (int bits = MAX_BINARY_DIGITS; bits > 0; bits--) {
+		const double denominator = std::ldexp(1.0, bits);
+		const double multiplier = std::round(signal.factor * denominator);
+		const double addend = std::round(signal.offset * denominator);
+		// A factor rounded away to zero would decode every value as the offset
+		if ((multiplier != 0 || signal.factor == 0) && std::fabs(multiplier) < SCALED_LIMIT && std::fabs(addend) < SCALED_LIMIT
+			&& fits(signal, static_cast<int64_t>(multiplier), static_cast<int64_t>(addend))) {
+			return FixedPointScale{static_cast<int64_t>(multiplier), static_cast<int64_t>(addend), int64_t(1) << bits, false, true};
+		}
+	}
+	return FixedPointScale{0, 0, 1, false, false};
+}
+
+FixedPointPlan::FixedPointPlan(const Message& message)
+	: m_id(message.id()) {
+	const auto& signals = message.get_signals();
+	m_signals.reserve(signals.size());
+	m_scales.reserve(signals.size());
+	for (std::size_t i = 0; i < signals.size(); i++) {
+		m_signals.push_back(SignalPlan(signals[i], i));
+		m_scales.push_back(FixedPointScale::from_signal(signals[i]));
+	}
+}
+
+uint32_t FixedPointPlan::id() const {
+	return m_id;
+}
+
+const std::vector<SignalPlan>& FixedPointPlan::signals() const {
+	return m_signals;
+}
+
+const std::vector<FixedPointScale>& FixedPointPlan::scales() const {
+	return m_scales;
+}
+
+std::vector<std::size_t> FixedPointPlan::inexact_signals() const {
+	std::vector<std::size_t> inexact;
+	for (std::size_t i = 0; i < m_scales.size(); i++) {
+		if (!m_scales[i].exact && m_scales[i].fixed_point) {
+			inexact.push_back(i);
+		}
+	}
+	return inexact;
+}
+
+std::vector<std::size_t> FixedPointPlan::unsupported_signals() const {
+	std::vector<std::size_t> unsupported;
+	for (std::size_t i = 0; i < m_scales.size(); i++) {
+		if (!m_scales[i].fixed_point) {
+			unsupported.push_back(i);
+		}
+	}
+	return unsupported;
+}
+
+Message::ParseSignalsStatus FixedPointPlan::decode(const uint8_t* data, std::size_t size, int64_t* values) const {
+	if (size > sizeof(uint64_t)) {
+		return Message::ParseSignalsStatus::ErrorMessageToLong; // not supported yet
+	}
+
+	const auto words = PayloadWords::load(data, size);
+	for (std::size_t i = 0; i < m_signals.size(); i++) {
+		const auto& scale = m_scales[i];
+		if (!scale.fixed_point) {
+			values[i] = 0;
+			continue;
+		}
+		// from_signal made sure the exact result fits, so the wrapping unsigned arithmetic gives that same two's complement value
+		const auto raw = static_cast<uint64_t>(m_signals[i].integer(m_signals[i].raw(words)));
+		values[i] = static_cast<int64_t>(raw * static_cast<uint64_t>(scale.multiplier) + static_cast<uint64_t>(scale.addend));
+	}
+	return Message::ParseSignalsStatus::Success;
+}
+
+Message::ParseSignalsStatus FixedPointPlan::decode(const std::vector<uint8_t>& data, std::vector<int64_t>& values) const {
+	const auto first = values.size();
+	values.resize(first + m_signals.size());
+	const auto status = decode(data.data(), data.size(), values.data() + first);
+	if (status != Message::ParseSignalsStatus::Success) {
+		values.resize(first);
+	}
+	return status;
+}
+
+}
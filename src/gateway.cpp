@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/gateway.hpp>
+#include <string>
+#include <vector>
+
+namespace Libdbc {
+
+constexpr std::size_t MAX_CLASSIC_PAYLOAD = 8;
+
+Gateway::Gateway(const DbcParser& source, const DbcParser& destination)
+	: m_source(source)
+	, m_destination(destination)
+	, m_routes(0)
+	, m_direct_routes(0) {
+}
+
+bool Gateway::add_route(const std::string& source_signal, const std::string& destination_signal) {
+	const auto from_handle = m_source.find_signal_handle(source_signal);
+	const auto to_handle = m_destination.find_signal_handle(destination_signal);
+	if (!from_handle.is_valid() || !to_handle.is_valid()) {
+		return false;
+	}
+
+	const auto& from_message = m_source.get_messages()[from_handle.message_index];
+	const auto& to_message = m_destination.get_messages()[to_handle.message_index];
+	SignalPlan from(m_source.get_signal(from_handle), from_handle.signal_index);
+	SignalPlan to(m_destination.get_signal(to_handle), to_handle.signal_index);
+	if (to.end_byte() > to_message.size() || to_message.size() > MAX_CLASSIC_PAYLOAD) {
+		return false;
+	}
+
+	auto found = m_destination_index.find(to_message.id());
+	if (found == m_destination_index.end()) {
+		found = m_destination_index.emplace(to_message.id(), m_destinations.size()).first;
+		m_destinations.push_back(Destination{to_message.id(), std::vector<uint8_t>(to_message.size(), 0)});
+	}
+	const std::size_t destination = found->second;
+
+	// Same scaling means the raw value is the same number, a wider destination only needs sign extension
+	const bool direct = from.factor == to.factor && from.offset == to.offset && from.is_signed == to.is_signed && to.size >= from.size;
+
+	auto& source = m_sources[from_message.id()];
+	source.moves.push_back(Move{from, to, destination, direct});
+	if (std::find(source.destinations.begin(), source.destinations.end(), destination) == source.destinations.end()) {
+		source.destinations.push_back(destination);
+	}
+
+	m_routes++;
+	if (direct) {
+		m_direct_routes++;
+	}
+	return true;
+}
+
+std::size_t Gateway::route(const Frame& frame, std::vector<Frame>& out) {
+	auto found = m_sources.find(frame.id);
+	if (found == m_sources.end() || frame.size > MAX_CLASSIC_PAYLOAD) {
+		return 0;
+	}
+
+	const auto& source = found->second;
+	Payload payload(frame.data, frame.size);
+	for (const auto& move : source.moves) {
+		uint8_t* data = m_destinations[move.destination].payload.data();
+		if (move.direct) {
+			move.to.insert(static_cast<uint64_t>(move.from.integer(move.from.raw(payload.words()))), data);
+		} else {
+			move.to.encode(move.from.decode(payload), data);
+		}
+	}
+
+	for (auto index : source.destinations) {
+		const auto& destination = m_destinations[index];
+		out.push_back(Frame{destination.id, destination.payload.data(), destination.payload.size(), frame.timestamp_ns});
+	}
+	return source.destinations.size();
+}
+
+std::size_t Gateway::route_count() const {
+	return m_routes;
+}
+
+std::size_t Gateway::direct_route_count() const {
+	return m_direct_routes;
+}
+
+}
@@ -0,0 +1,26 @@
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/id_filter.hpp>
+
+namespace Libdbc {
+
+constexpr std::size_t IdFilter::BITS;
+
+void IdFilter::insert(uint32_t message_id) {
+	m_bits[bit_for(message_id)] = true;
+}
+
+bool IdFilter::may_contain(uint32_t message_id) const {
+	return m_bits[bit_for(message_id)];
+}
+
+void IdFilter::clear() {
+	m_bits.reset();
+}
+
+std::size_t IdFilter::bit_for(uint32_t message_id) {
+	// Fold the upper id bits down so extended ids spread over the whole bitmap
+	return static_cast<std::size_t>((message_id ^ (message_id >> 12) ^ (message_id >> 24)) & (BITS - 1));
+}
+
+}
@@ -0,0 +1,120 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_observer.hpp>
+#include <libdbc/last_value_store.hpp>
+#include <vector>
+
+namespace Libdbc {
+
+static uint64_t double_to_bits(double value) {
+	uint64_t bits = 0;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static double bits_to_double(uint64_t bits) {
+	double value = 0;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+LastValueStore::LastValueStore(const DbcParser& parser)
+	: m_message_count(parser.get_messages().size())
+	, m_slots(new MessageSlot[parser.get_messages().size()])
+	, m_read_retries(0) {
+	std::size_t total_values = 0;
+	for (std::size_t i = 0; i < m_message_count; i++) {
+		auto& slot = m_slots[i];
+		slot.sequence.store(0, std::memory_order_relaxed);
+		slot.timestamp_ns.store(0, std::memory_order_relaxed);
+		slot.first_value = total_values;
+		slot.value_count = parser.get_messages()[i].get_signals().size();
+		total_values += slot.value_count;
+	}
+
+	m_values.reset(new std::atomic<uint64_t>[total_values]);
+	for (std::size_t i = 0; i < total_values; i++) {
+		m_values[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+void LastValueStore::on_decoded(const DecodedMessage& decoded) {
+	if (decoded.message_index >= m_message_count) {
+		return;
+	}
+
+	auto& slot = m_slots[decoded.message_index];
+
+	// Take the slot by moving the sequence to an odd value. Only concurrent writers of the same message wait here.
+	uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+	do {
+		while ((sequence & 1U) != 0) {
+			sequence = slot.sequence.load(std::memory_order_relaxed);
+		}
+	} while (!slot.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed));
+	std::atomic_thread_fence(std::memory_order_release);
+
+	const auto count = decoded.value_count < slot.value_count ? decoded.value_count : slot.value_count;
+	for (std::size_t i = 0; i < count; i++) {
+		m_values[slot.first_value + i].store(double_to_bits(decoded.values[i]), std::memory_order_relaxed);
+	}
+	slot.timestamp_ns.store(decoded.timestamp_ns, std::memory_order_relaxed);
+
+	slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+uint32_t LastValueStore::begin_read(const MessageSlot& slot) const {
+	uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+	if ((sequence & 1U) == 0) {
+		return sequence;
+	}
+
+	m_read_retries.fetch_add(1, std::memory_order_relaxed);
+	while ((sequence & 1U) != 0) {
+		sequence = slot.sequence.load(std::memory_order_acquire);
+	}
+	return sequence;
+}
+
+bool LastValueStore::end_read(const MessageSlot& slot, uint32_t sequence) const {
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+		return true;
+	}
+	m_read_retries.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+LastValueStore::Sample LastValueStore::read(const SignalHandle& handle) const {
+	Sample sample{0, 0, false};
+	if (handle.message_index >= m_message_count || handle.signal_index >= m_slots[handle.message_index].value_count) {
+		return sample;
+	}
+
+	const auto& slot = m_slots[handle.message_index];
+	uint32_t sequence = 0;
+	do {
+		sequence = begin_read(slot);
+		sample.value = bits_to_double(m_values[slot.first_value + handle.signal_index].load(std::memory_order_relaxed));
+		sample.timestamp_ns = slot.timestamp_ns.load(std::memory_order_relaxed);
+	} while (!end_read(slot, sequence));
+
+	sample.valid = sequence != 0;
+	return sample;
+}
+
+void LastValueStore::snapshot(const std::vector<SignalHandle>& handles, std::vector<Sample>& samples) const {
+	samples.resize(handles.size());
+	for (std::size_t i = 0; i < handles.size(); i++) {
+		samples[i] = read(handles[i]);
+	}
+}
+
+uint64_t LastValueStore::read_retries() const {
+	return m_read_retries.load(std::memory_order_relaxed);
+}
+
+}
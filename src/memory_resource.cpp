@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/memory_resource.hpp>
+#include <new>
+
+namespace Libdbc {
+
+namespace {
+
+class NewDeleteResource : public MemoryResource {
+public:
+	void* allocate(std::size_t bytes, std::size_t) override {
+		return ::operator new(bytes);
+	}
+
+	void deallocate(void* pointer, std::size_t, std::size_t) override {
+		::operator delete(pointer);
+	}
+};
+
+std::size_t padding_for(const char* position, std::size_t alignment) {
+	const auto address = reinterpret_cast<std::uintptr_t>(position);
+	return (alignment - address % alignment) % alignment;
+}
+
+}
+
+MemoryResource& default_resource() {
+	static NewDeleteResource resource;
+	return resource;
+}
+
+MonotonicResource::MonotonicResource(std::size_t chunk_size, MemoryResource& upstream)
+	: MonotonicResource(nullptr, 0, upstream) {
+	m_chunk_size = std::max<std::size_t>(chunk_size, sizeof(Chunk) + 1);
+}
+
+MonotonicResource::MonotonicResource(void* buffer, std::size_t size, MemoryResource& upstream)
+	: m_upstream(upstream)
+	, m_buffer(static_cast<char*>(buffer))
+	, m_buffer_size(buffer == nullptr ? 0 : size)
+	, m_chunk_size(4096)
+	, m_chunks(nullptr)
+	, m_chunk_count(0)
+	, m_current(m_buffer)
+	, m_available(m_buffer_size)
+	, m_allocated(0) {
+}
+
+MonotonicResource::~MonotonicResource() {
+	release();
+}
+
+void* MonotonicResource::allocate(std::size_t bytes, std::size_t alignment) {
+	std::size_t padding = m_current == nullptr ? 0 : padding_for(m_current, alignment);
+	if (m_current == nullptr || padding + bytes > m_available) {
+		// Chunks double in size so a large database needs only a few of them
+		const std::size_t needed = sizeof(Chunk) + bytes + alignment;
+		const std::size_t size = std::max(m_chunk_size, needed);
+		m_chunk_size = size * 2;
+
+		void* memory = m_upstream.allocate(size, alignof(std::max_align_t));
+		m_chunks = new (memory) Chunk{m_chunks, size};
+		m_chunk_count++;
+		m_current = static_cast<char*>(memory) + sizeof(Chunk);
+		m_available = size - sizeof(Chunk);
+		padding = padding_for(m_current, alignment);
+	}
+
+	char* result = m_current + padding;
+	m_current = result + bytes;
+	m_available -= padding + bytes;
+	m_allocated += padding + bytes;
+	return result;
+}
+
+void MonotonicResource::deallocate(void*, std::size_t, std::size_t) {
+}
+
+void MonotonicResource::release() {
+	while (m_chunks != nullptr) {
+		Chunk* next = m_chunks->next;
+		m_upstream.deallocate(m_chunks, m_chunks->size, alignof(std::max_align_t));
+		m_chunks = next;
+	}
+	m_chunk_count = 0;
+	m_current = m_buffer;
+	m_available = m_buffer_size;
+	m_allocated = 0;
+}
+
+std::size_t MonotonicResource::bytes_allocated() const {
+	return m_allocated;
+}
+
+std::size_t MonotonicResource::upstream_chunks() const {
+	return m_chunk_count;
+}
+
+}
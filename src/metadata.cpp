@@ -0,0 +1,269 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <libdbc/metadata.hpp>
+#include <libdbc/utils/utils.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Libdbc {
+
+namespace {
+
+struct Token {
+	std::string text;
+	bool quoted;
+};
+
+bool is_delimiter(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ';' || c == '"';
+}
+
+/**
+ * Splits the next statement off text. A statement ends at ';' or at a line break outside of a
+ * string, so a line missing its ';' doesn't swallow the next one.
+ */
+bool next_statement(const std::string& text, std::size_t& position, std::vector<Token>& tokens) {
+	tokens.clear();
+	while (position < text.size()) {
+		const char c = text[position];
+		if (c == ';' || c == '\n') {
+			position++;
+			if (!tokens.empty()) {
+				return true;
+			}
+			continue;
+		}
+		if (c == ' ' || c == '\t' || c == '\r') {
+			position++;
+			continue;
+		}
+
+		if (c == '"') {
+			Token token{std::string(), true};
+			position++;
+			while (position < text.size() && text[position] != '"') {
+				token.text += text[position++];
+			}
+			position++;
+			tokens.push_back(token);
+			continue;
+		}
+
+		const std::size_t start = position;
+		while (position < text.size() && !is_delimiter(text[position])) {
+			position++;
+		}
+		tokens.push_back(Token{text.substr(start, position - start), false});
+	}
+	return !tokens.empty();
+}
+
+std::string message_key(uint32_t message_id) {
+	return "BO_ " + std::to_string(message_id);
+}
+
+std::string signal_key(uint32_t message_id, const std::string& signal_name) {
+	return "SG_ " + std::to_string(message_id) + ' ' + signal_name;
+}
+
+std::string attribute_key(const std::string& name, const std::string& object) {
+	return name + '\n' + object;
+}
+
+uint32_t message_id_of(const Token& token) {
+	return static_cast<uint32_t>(Utils::String::convert_to_unsigned(token.text));
+}
+
+// Reads the object a CM_ or BA_ statement refers to, starting at tokens[first]. Returns the index after it.
+std::size_t read_object(const std::vector<Token>& tokens, std::size_t first, std::string& object) {
+	object.clear();
+	if (first >= tokens.size() || tokens[first].quoted) {
+		return first;
+	}
+
+	const auto& kind = tokens[first].text;
+	if ((kind == "BU_" || kind == "EV_") && first + 1 < tokens.size()) {
+		object = kind + ' ' + tokens[first + 1].text;
+		return first + 2;
+	}
+	if (kind == "BO_" && first + 1 < tokens.size()) {
+		object = message_key(message_id_of(tokens[first + 1]));
+		return first + 2;
+	}
+	if (kind == "SG_" && first + 2 < tokens.size()) {
+		object = signal_key(message_id_of(tokens[first + 1]), tokens[first + 2].text);
+		return first + 3;
+	}
+	return first;
+}
+
+const char* const STATEMENT_KEYWORDS[] = {
+	"BO_ ", "SG_ ", "VAL_ ", "CM_ ", "BA_ ", "BA_DEF_ ", "BA_DEF_DEF_ ", "BA_DEF_REL_ ", "BA_REL_ ",
+	"VAL_TABLE_ ", "BO_TX_BU_ ", "EV_ ", "SIG_VALTYPE_ ", "SIG_GROUP_ ", "SG_MUL_VAL_ ",
+};
+
+}
+
+Metadata::Metadata(const Metadata& other) {
+	*this = other;
+}
+
+Metadata& Metadata::operator=(const Metadata& other) {
+	if (this != &other) {
+		std::lock_guard<std::mutex> lock(other.m_index_mutex);
+		m_text = other.m_text;
+		m_in_string = other.m_in_string;
+		m_comments = other.m_comments;
+		m_attributes = other.m_attributes;
+		m_defaults = other.m_defaults;
+		m_indexed = other.m_indexed.load();
+	}
+	return *this;
+}
+
+bool Metadata::is_metadata_line(const std::string& line) {
+	return line.compare(0, 4, "CM_ ") == 0 || line.compare(0, 4, "BA_ ") == 0 || line.compare(0, 12, "BA_DEF_DEF_ ") == 0;
+}
+
+bool Metadata::is_statement_start(const std::string& line) {
+	const auto first = line.find_first_not_of(" \t");
+	if (first == std::string::npos) {
+		return false;
+	}
+	for (const char* keyword : STATEMENT_KEYWORDS) {
+		if (line.compare(first, std::strlen(keyword), keyword) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool Metadata::append(const std::string& line) {
+	m_text += line;
+	m_text += '\n';
+	for (const char c : line) {
+		if (c == '"') {
+			m_in_string = !m_in_string;
+		}
+	}
+	return m_in_string;
+}
+
+void Metadata::end_statement() {
+	if (!m_in_string) {
+		return;
+	}
+	if (!m_text.empty() && m_text.back() == '\n') {
+		m_text.pop_back();
+	}
+	m_text += "\"\n";
+	m_in_string = false;
+}
+
+void Metadata::clear() {
+	m_text.clear();
+	m_in_string = false;
+	m_indexed = false;
+	m_comments.clear();
+	m_attributes.clear();
+	m_defaults.clear();
+}
+
+void Metadata::index() const {
+	if (m_indexed.load(std::memory_order_acquire)) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(m_index_mutex);
+	if (m_indexed.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	std::vector<Token> tokens;
+	std::string object;
+	std::size_t position = 0;
+	while (next_statement(m_text, position, tokens)) {
+		const auto& keyword = tokens[0].text;
+		if (keyword == "CM_") {
+			const std::size_t text = read_object(tokens, 1, object);
+			if (text < tokens.size() && tokens[text].quoted) {
+				m_comments[object] = tokens[text].text;
+			}
+		} else if (keyword == "BA_" && tokens.size() > 2 && tokens[1].quoted) {
+			const std::size_t value = read_object(tokens, 2, object);
+			if (value < tokens.size()) {
+				m_attributes[attribute_key(tokens[1].text, object)] = tokens[value].text;
+			}
+		} else if (keyword == "BA_DEF_DEF_" && tokens.size() > 2 && tokens[1].quoted) {
+			m_defaults[tokens[1].text] = tokens[2].text;
+		}
+	}
+
+	// The tables hold everything now
+	std::string().swap(m_text);
+	m_indexed.store(true, std::memory_order_release);
+}
+
+const std::string* Metadata::find(const std::unordered_map<std::string, std::string>& table, const std::string& key) const {
+	index();
+	auto found = table.find(key);
+	return found == table.end() ? nullptr : &found->second;
+}
+
+const std::string* Metadata::find_attribute(const std::string& name, const std::string& object) const {
+	const std::string* value = find(m_attributes, attribute_key(name, object));
+	return value != nullptr ? value : find(m_defaults, name);
+}
+
+const std::string* Metadata::database_comment() const {
+	return find(m_comments, std::string());
+}
+
+const std::string* Metadata::node_comment(const std::string& node) const {
+	return find(m_comments, "BU_ " + node);
+}
+
+const std::string* Metadata::message_comment(uint32_t message_id) const {
+	return find(m_comments, message_key(message_id));
+}
+
+const std::string* Metadata::signal_comment(uint32_t message_id, const std::string& signal_name) const {
+	return find(m_comments, signal_key(message_id, signal_name));
+}
+
+const std::string* Metadata::attribute(const std::string& name) const {
+	return find_attribute(name, std::string());
+}
+
+const std::string* Metadata::node_attribute(const std::string& name, const std::string& node) const {
+	return find_attribute(name, "BU_ " + node);
+}
+
+const std::string* Metadata::message_attribute(const std::string& name, uint32_t message_id) const {
+	return find_attribute(name, message_key(message_id));
+}
+
+const std::string* Metadata::signal_attribute(const std::string& name, uint32_t message_id, const std::string& signal_name) const {
+	return find_attribute(name, signal_key(message_id, signal_name));
+}
+
+bool Metadata::is_indexed() const {
+	return m_indexed;
+}
+
+std::size_t Metadata::memory_bytes() const {
+	std::lock_guard<std::mutex> lock(m_index_mutex);
+	std::size_t bytes = m_text.capacity();
+	for (const auto* table : {&m_comments, &m_attributes, &m_defaults}) {
+		bytes += table->bucket_count() * sizeof(void*);
+		for (const auto& entry : *table) {
+			bytes += sizeof(entry) + sizeof(void*) + entry.first.capacity() + entry.second.capacity();
+		}
+	}
+	return bytes;
+}
+
+}
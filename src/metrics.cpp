@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/metrics.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Libdbc {
+namespace Metrics {
+
+static uint64_t metrics_now_ns() {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+#if defined(DBC_ENABLE_METRICS)
+
+constexpr std::size_t CACHE_LINE = 64;
+constexpr std::size_t ID_SLOTS = 4096;
+
+// Only the owning thread writes, so plain load/store pairs are enough and readers never tear a value.
+static void bump(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+	counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+struct IdSlot {
+	std::atomic<uint64_t> id_plus_one;
+	std::atomic<uint64_t> frames;
+};
+
+struct ThreadCounters {
+	std::atomic<bool> in_use;
+	char padding_front[CACHE_LINE];
+
+	std::atomic<uint64_t> frames_decoded;
+	std::atomic<uint64_t> unknown_id;
+	std::atomic<uint64_t> message_too_long;
+	std::atomic<uint64_t> untracked_frames;
+	std::atomic<uint64_t> latency[LATENCY_BUCKETS];
+	IdSlot ids[ID_SLOTS];
+
+	char padding_back[CACHE_LINE];
+
+	ThreadCounters()
+		: in_use(true) {
+		clear();
+	}
+
+	void clear() {
+		frames_decoded.store(0, std::memory_order_relaxed);
+		unknown_id.store(0, std::memory_order_relaxed);
+		message_too_long.store(0, std::memory_order_relaxed);
+		untracked_frames.store(0, std::memory_order_relaxed);
+		for (auto& bucket : latency) {
+			bucket.store(0, std::memory_order_relaxed);
+		}
+		for (auto& slot : ids) {
+			slot.frames.store(0, std::memory_order_relaxed);
+			slot.id_plus_one.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void count_message(uint32_t message_id) {
+		// Open addressing, only this thread inserts so claiming an empty slot can't race
+		const uint64_t key = static_cast<uint64_t>(message_id) + 1;
+		std::size_t index = (message_id * 2654435761U) % ID_SLOTS;
+		for (std::size_t probe = 0; probe < ID_SLOTS; probe++) {
+			auto& slot = ids[(index + probe) % ID_SLOTS];
+			const auto current = slot.id_plus_one.load(std::memory_order_relaxed);
+			if (current == key) {
+				bump(slot.frames);
+				return;
+			}
+			if (current == 0) {
+				slot.frames.store(1, std::memory_order_relaxed);
+				slot.id_plus_one.store(key, std::memory_order_release);
+				return;
+			}
+		}
+		bump(untracked_frames);
+	}
+};
+
+struct Registry {
+	std::mutex mutex;
+	std::vector<std::unique_ptr<ThreadCounters>> blocks;
+};
+
+static Registry& registry() {
+	static Registry instance;
+	return instance;
+}
+
+// Hands the block back when the thread exits. The counts stay and a new thread may continue on top of them.
+struct ThreadCountersLease {
+	ThreadCounters* counters = nullptr;
+
+	~ThreadCountersLease() {
+		if (counters != nullptr) {
+			counters->in_use.store(false, std::memory_order_release);
+		}
+	}
+};
+
+static ThreadCounters& local_counters() {
+	thread_local ThreadCountersLease lease;
+	if (lease.counters != nullptr) {
+		return *lease.counters;
+	}
+
+	auto& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	for (auto& block : reg.blocks) {
+		bool expected = false;
+		if (block->in_use.compare_exchange_strong(expected, true)) {
+			lease.counters = block.get();
+			return *lease.counters;
+		}
+	}
+	reg.blocks.emplace_back(new ThreadCounters());
+	lease.counters = reg.blocks.back().get();
+	return *lease.counters;
+}
+
+static std::size_t latency_bucket(uint64_t latency_ns) {
+	std::size_t bucket = 0;
+	while (latency_ns > 1 && bucket + 1 < LATENCY_BUCKETS) {
+		latency_ns >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+bool enabled() {
+	return true;
+}
+
+void record_decoded(uint32_t message_id, uint64_t latency_ns) {
+	auto& counters = local_counters();
+	bump(counters.frames_decoded);
+	bump(counters.latency[latency_bucket(latency_ns)]);
+	counters.count_message(message_id);
+}
+
+void record_unknown_id() {
+	bump(local_counters().unknown_id);
+}
+
+void record_message_too_long() {
+	bump(local_counters().message_too_long);
+}
+
+Snapshot snapshot() {
+	Snapshot result{true, metrics_now_ns(), 0, 0, 0, {}, 0, std::vector<uint64_t>(LATENCY_BUCKETS, 0)};
+
+	auto& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	for (const auto& block : reg.blocks) {
+		result.frames_decoded += block->frames_decoded.load(std::memory_order_relaxed);
+		result.unknown_id += block->unknown_id.load(std::memory_order_relaxed);
+		result.message_too_long += block->message_too_long.load(std::memory_order_relaxed);
+		result.untracked_frames += block->untracked_frames.load(std::memory_order_relaxed);
+		for (std::size_t i = 0; i < LATENCY_BUCKETS; i++) {
+			result.decode_latency_ns[i] += block->latency[i].load(std::memory_order_relaxed);
+		}
+		for (const auto& slot : block->ids) {
+			const auto key = slot.id_plus_one.load(std::memory_order_acquire);
+			if (key != 0) {
+				result.frames_per_message.push_back(MessageCount{static_cast<uint32_t>(key - 1), slot.frames.load(std::memory_order_relaxed)});
+			}
+		}
+	}
+
+	// Merge the per thread entries of the same id
+	std::sort(result.frames_per_message.begin(), result.frames_per_message.end(), [](const MessageCount& lhs, const MessageCount& rhs) {
+		return lhs.message_id < rhs.message_id;
+	});
+	std::vector<MessageCount> merged;
+	for (const auto& count : result.frames_per_message) {
+		if (!merged.empty() && merged.back().message_id == count.message_id) {
+			merged.back().frames += count.frames;
+		} else {
+			merged.push_back(count);
+		}
+	}
+	result.frames_per_message.swap(merged);
+	return result;
+}
+
+void reset() {
+	// Counters of running threads are cleared underneath them, a racing increment may survive the reset
+	auto& reg = registry();
+	std::lock_guard<std::mutex> lock(reg.mutex);
+	for (auto& block : reg.blocks) {
+		block->clear();
+	}
+}
+
+#else
+
+bool enabled() {
+	return false;
+}
+
+void record_decoded(uint32_t, uint64_t) {
+}
+
+void record_unknown_id() {
+}
+
+void record_message_too_long() {
+}
+
+Snapshot snapshot() {
+	return Snapshot{false, metrics_now_ns(), 0, 0, 0, {}, 0, {}};
+}
+
+void reset() {
+}
+
+#endif
+
+std::vector<MessageRate> rates(const Snapshot& before, const Snapshot& after) {
+	std::vector<MessageRate> result;
+	if (after.taken_at_ns <= before.taken_at_ns) {
+		return result;
+	}
+
+	const double seconds = static_cast<double>(after.taken_at_ns - before.taken_at_ns) / 1e9;
+	auto previous = before.frames_per_message.begin();
+	for (const auto& count : after.frames_per_message) {
+		while (previous != before.frames_per_message.end() && previous->message_id < count.message_id) {
+			++previous;
+		}
+		uint64_t earlier = 0;
+		if (previous != before.frames_per_message.end() && previous->message_id == count.message_id) {
+			earlier = previous->frames;
+		}
+		const uint64_t frames = count.frames >= earlier ? count.frames - earlier : count.frames;
+		result.push_back(MessageRate{count.message_id, static_cast<double>(frames) / seconds});
+	}
+	return result;
+}
+
+}
+}
@@ -0,0 +1,76 @@
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/message.hpp>
+#include <libdbc/node_view.hpp>
+#include <string>
+#include <vector>
+
+namespace Libdbc {
+
+NodeView::NodeView(const DbcParser& parser, const std::string& node)
+	: m_node(node) {
+	std::vector<std::size_t> signal_indices;
+
+	for (const auto& message : parser.get_messages()) {
+		const auto& signals = message.get_signals();
+		const bool transmits = message.node() == node;
+
+		signal_indices.clear();
+		for (std::size_t i = 0; i < signals.size(); i++) {
+			if (transmits) {
+				signal_indices.push_back(i);
+				continue;
+			}
+			for (const auto& receiver : signals[i].receivers) {
+				if (receiver == node) {
+					signal_indices.push_back(i);
+					break;
+				}
+			}
+		}
+
+		if (signal_indices.empty() || m_id_index.count(message.id()) != 0) {
+			continue;
+		}
+
+		m_id_index.emplace(message.id(), m_plans.size());
+		m_filter.insert(message.id());
+		m_plans.push_back(DecodePlan(message, signal_indices));
+	}
+}
+
+const std::string& NodeView::node() const {
+	return m_node;
+}
+
+const std::vector<DecodePlan>& NodeView::plans() const {
+	return m_plans;
+}
+
+bool NodeView::accepts(uint32_t message_id) const {
+	return find_plan(message_id) != nullptr;
+}
+
+const DecodePlan* NodeView::find_plan(uint32_t message_id) const {
+	if (!m_filter.may_contain(message_id)) {
+		return nullptr;
+	}
+
+	auto found = m_id_index.find(message_id);
+	if (found == m_id_index.end()) {
+		return nullptr;
+	}
+	return &m_plans[found->second];
+}
+
+Message::ParseSignalsStatus NodeView::parse_message(uint32_t message_id, const std::vector<uint8_t>& data, std::vector<double>& out_values) const {
+	const auto* plan = find_plan(message_id);
+	if (plan == nullptr) {
+		return Message::ParseSignalsStatus::ErrorUnknownID;
+	}
+	return plan->decode(data, out_values);
+}
+
+}
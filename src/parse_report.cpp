@@ -0,0 +1,40 @@
+#include <cstddef>
+#include <libdbc/parse_report.hpp>
+#include <ostream>
+
+namespace Libdbc {
+
+std::size_t ParseReport::total_bytes() const {
+	return message_bytes + signal_bytes + string_bytes + value_description_bytes + index_bytes;
+}
+
+static double to_milliseconds(uint64_t nanoseconds) {
+	return static_cast<double>(nanoseconds) / 1e6;
+}
+
+std::ostream& operator<<(std::ostream& out, const ParseReport& report) {
+	out << "Parse time (ms):\n";
+	out << "  header:             " << to_milliseconds(report.header_ns) << "\n";
+	out << "  nodes:              " << to_milliseconds(report.nodes_ns) << "\n";
+	out << "  read lines:         " << to_milliseconds(report.read_lines_ns) << "\n";
+	out << "  messages:           " << to_milliseconds(report.messages_ns) << "\n";
+	out << "  indexes:            " << to_milliseconds(report.indexes_ns) << "\n";
+	out << "  value descriptions: " << to_milliseconds(report.value_descriptions_ns) << "\n";
+	out << "  total:              " << to_milliseconds(report.total_ns) << "\n";
+
+	out << "Lines: " << report.lines << " (unmatched: " << report.missed_lines << ")\n";
+	for (const auto& keyword : report.keyword_lines) {
+		out << "  " << keyword.first << ": " << keyword.second << "\n";
+	}
+
+	out << "Memory (bytes):\n";
+	out << "  messages:           " << report.message_bytes << "\n";
+	out << "  signals:            " << report.signal_bytes << "\n";
+	out << "  strings:            " << report.string_bytes << "\n";
+	out << "  value descriptions: " << report.value_description_bytes << "\n";
+	out << "  indexes:            " << report.index_bytes << "\n";
+	out << "  total:              " << report.total_bytes() << "\n";
+	return out;
+}
+
+}
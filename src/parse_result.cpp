@@ -0,0 +1,27 @@
+#include <libdbc/parse_result.hpp>
+#include <string>
+
+namespace Libdbc {
+
+bool ParseResult::ok() const {
+	return error == ParseError::None;
+}
+
+std::string ParseResult::message() const {
+	const std::string position = "line " + std::to_string(line) + ", column " + std::to_string(column) + ": ";
+	switch (error) {
+	case ParseError::None:
+		return "";
+	case ParseError::NonDbcFileFormat:
+		return "File is not of DBC format. Expected a .dbc extension (" + context + ").";
+	case ParseError::CannotOpenFile:
+		return "Unable to open the file (" + context + ").";
+	case ParseError::MissingVersion:
+		return position + "Missing the required version header. Found (" + context + ").";
+	case ParseError::MissingBitTiming:
+		return position + "Missing required bit timing in the header. Found (" + context + ").";
+	}
+	return "";
+}
+
+}
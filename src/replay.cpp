@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/replay.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Libdbc {
+
+constexpr std::size_t Replay::npos;
+constexpr uint64_t Replay::SPIN_NS;
+
+static uint64_t steady_now_ns() {
+	const auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+void LocalFrameSink::send(const Frame& frame) {
+	m_frames.push_back(Received{frame.id, std::vector<uint8_t>(frame.data, frame.data + frame.size), frame.timestamp_ns, steady_now_ns()});
+}
+
+const std::vector<LocalFrameSink::Received>& LocalFrameSink::frames() const {
+	return m_frames;
+}
+
+void LocalFrameSink::clear() {
+	m_frames.clear();
+}
+
+Replay::Replay(const DbcParser& parser, FrameSink& sink)
+	: m_parser(parser)
+	, m_sink(sink)
+	, m_reencoded(0)
+	, m_prepared(false)
+	, m_stop(false) {
+}
+
+void Replay::add_frame(const Frame& frame) {
+	m_entries.push_back(Entry{frame.id, frame.timestamp_ns, m_recorded.size(), frame.size, npos, frame.size});
+	m_recorded.insert(m_recorded.end(), frame.data, frame.data + frame.size);
+	m_prepared = false;
+}
+
+void Replay::add_frames(const std::vector<Frame>& frames) {
+	for (const auto& frame : frames) {
+		add_frame(frame);
+	}
+}
+
+void Replay::clear() {
+	m_entries.clear();
+	m_recorded.clear();
+	m_encoded.clear();
+	m_reencoded = 0;
+	m_prepared = false;
+}
+
+bool Replay::override_signal(const std::string& qualified_name, double value) {
+	const auto handle = m_parser.find_signal_handle(qualified_name);
+	if (!handle.is_valid()) {
+		return false;
+	}
+
+	const auto& message = m_parser.get_messages()[handle.message_index];
+	auto& overrides = m_overrides[message.id()];
+	for (auto& existing : overrides) {
+		if (existing.signal.signal_index == handle.signal_index) {
+			existing.value = value;
+			m_prepared = false;
+			return true;
+		}
+	}
+	overrides.push_back(Override{SignalPlan(m_parser.get_signal(handle), handle.signal_index), value});
+	m_prepared = false;
+	return true;
+}
+
+void Replay::clear_overrides() {
+	m_overrides.clear();
+	m_prepared = false;
+}
+
+void Replay::prepare() {
+	m_stop = false;
+	encode_overrides();
+}
+
+void Replay::encode_overrides() {
+	std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry& lhs, const Entry& rhs) {
+		return lhs.timestamp_ns < rhs.timestamp_ns;
+	});
+
+	m_encoded.clear();
+	m_reencoded = 0;
+	for (auto& entry : m_entries) {
+		entry.encoded = npos;
+		entry.size = entry.recorded_size;
+		auto found = m_overrides.find(entry.id);
+		if (found == m_overrides.end()) {
+			continue;
+		}
+
+		// Start from the recorded bytes so the signals that aren't overridden keep their values
+		std::size_t size = entry.recorded_size;
+		for (const auto& override_value : found->second) {
+			size = std::max(size, override_value.signal.end_byte());
+		}
+		entry.encoded = m_encoded.size();
+		m_encoded.resize(m_encoded.size() + size, 0);
+		std::copy(m_recorded.begin() + static_cast<std::ptrdiff_t>(entry.original),
+				  m_recorded.begin() + static_cast<std::ptrdiff_t>(entry.original + entry.recorded_size),
+				  m_encoded.begin() + static_cast<std::ptrdiff_t>(entry.encoded));
+		for (const auto& override_value : found->second) {
+			override_value.signal.encode(override_value.value, m_encoded.data() + entry.encoded);
+		}
+		entry.size = size;
+		m_reencoded++;
+	}
+	m_prepared = true;
+}
+
+void Replay::run(double rate) {
+	if (!m_prepared) {
+		encode_overrides();
+	}
+	if (m_entries.empty()) {
+		return;
+	}
+
+	const uint64_t first_timestamp = m_entries.front().timestamp_ns;
+	const uint64_t start = steady_now_ns();
+	for (const auto& entry : m_entries) {
+		if (m_stop) {
+			break;
+		}
+
+		if (rate > 0) {
+			const auto offset = static_cast<uint64_t>(static_cast<double>(entry.timestamp_ns - first_timestamp) / rate);
+			if (!wait_until(start + offset)) {
+				break;
+			}
+		}
+
+		const uint8_t* data = entry.encoded == npos ? m_recorded.data() + entry.original : m_encoded.data() + entry.encoded;
+		m_sink.send(Frame{entry.id, data, entry.size, entry.timestamp_ns});
+	}
+}
+
+bool Replay::wait_until(uint64_t due) {
+	if (steady_now_ns() + SPIN_NS < due) {
+		const std::chrono::steady_clock::time_point wake_at(
+			std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(due - SPIN_NS)));
+		std::unique_lock<std::mutex> lock(m_stop_mutex);
+		m_stop_changed.wait_until(lock, wake_at, [this]() {
+			return m_stop.load();
+		});
+	}
+	while (steady_now_ns() < due && !m_stop) {
+	}
+	return !m_stop;
+}
+
+void Replay::stop() {
+	{
+		// Under the lock so a run() about to wait can't miss the notification
+		std::lock_guard<std::mutex> lock(m_stop_mutex);
+		m_stop = true;
+	}
+	m_stop_changed.notify_all();
+}
+
+std::size_t Replay::frame_count() const {
+	return m_entries.size();
+}
+
+std::size_t Replay::reencoded_count() const {
+	return m_reencoded;
+}
+
+}
@@ -1,7 +1,10 @@
 #include <cstdint>
+#include <libdbc/memory_resource.hpp>
 #include <libdbc/signal.hpp>
+#include <libdbc/string_pool.hpp>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Libdbc {
@@ -17,7 +20,34 @@ Signal::Signal(std::string name,
 			   double max,
 			   std::string unit,
 			   std::vector<std::string> receivers)
-	: name(name)
+	: Signal(std::move(name),
+			 is_multiplexed,
+			 start_bit,
+			 size,
+			 is_bigendian,
+			 is_signed,
+			 factor,
+			 offset,
+			 min,
+			 max,
+			 InternedString(unit),
+			 std::vector<InternedString>(receivers.begin(), receivers.end())) {
+}
+
+Signal::Signal(std::string name,
+			   bool is_multiplexed,
+			   uint32_t start_bit,
+			   uint32_t size,
+			   bool is_bigendian,
+			   bool is_signed,
+			   double factor,
+			   double offset,
+			   double min,
+			   double max,
+			   InternedString unit,
+			   const std::vector<InternedString>& receivers,
+			   MemoryResource& resource)
+	: name(std::move(name))
 	, is_multiplexed(is_multiplexed)
 	, start_bit(start_bit)
 	, size(size)
@@ -27,8 +57,25 @@ Signal::Signal(std::string name,
 	, offset(offset)
 	, min(min)
 	, max(max)
-	, unit(unit)
-	, receivers(receivers) {
+	, unit(std::move(unit))
+	, receivers(receivers.begin(), receivers.end(), Allocator<InternedString>(resource))
+	, value_descriptions(Allocator<ValueDescription>(resource)) {
+}
+
+Signal::Signal(const Signal& other, MemoryResource& resource)
+	: name(other.name)
+	, is_multiplexed(other.is_multiplexed)
+	, start_bit(other.start_bit)
+	, size(other.size)
+	, is_bigendian(other.is_bigendian)
+	, is_signed(other.is_signed)
+	, factor(other.factor)
+	, offset(other.offset)
+	, min(other.min)
+	, max(other.max)
+	, unit(other.unit)
+	, receivers(other.receivers.begin(), other.receivers.end(), Allocator<InternedString>(resource))
+	, value_descriptions(other.value_descriptions.begin(), other.value_descriptions.end(), Allocator<ValueDescription>(resource)) {
 }
 
 bool Signal::operator==(const Signal& rhs) const {
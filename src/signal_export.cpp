@@ -0,0 +1,412 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <libdbc/dbc.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/signal_export.hpp>
+#include <libdbc/utils/utils.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Libdbc {
+
+static const char COLUMNAR_MAGIC[] = {'D', 'B', 'C', 'C'};
+constexpr uint8_t COLUMNAR_VERSION = 1;
+constexpr std::size_t CHUNK_HEADER_SIZE = 12;
+
+static void put_u16(std::vector<uint8_t>& buffer, uint16_t value) {
+	buffer.push_back(static_cast<uint8_t>(value));
+	buffer.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+static void put_u32(std::vector<uint8_t>& buffer, uint32_t value) {
+	for (unsigned shift = 0; shift < 32; shift += 8) {
+		buffer.push_back(static_cast<uint8_t>(value >> shift));
+	}
+}
+
+static void put_u64(std::vector<uint8_t>& buffer, uint64_t value) {
+	for (unsigned shift = 0; shift < 64; shift += 8) {
+		buffer.push_back(static_cast<uint8_t>(value >> shift));
+	}
+}
+
+static void put_varint(std::vector<uint8_t>& buffer, uint64_t value) {
+	while (value >= 0x80) {
+		buffer.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(static_cast<uint8_t>(value));
+}
+
+static uint64_t double_bits(double value) {
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static double bits_double(uint64_t bits) {
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+// Reads from a chunk payload, any read past the end marks it as broken
+class ChunkReader {
+public:
+	ChunkReader(const uint8_t* data, std::size_t size)
+		: m_data(data)
+		, m_end(data + size)
+		, m_ok(true) {
+	}
+
+	uint8_t byte() {
+		if (m_data == m_end) {
+			m_ok = false;
+			return 0;
+		}
+		return *m_data++;
+	}
+
+	uint64_t fixed(unsigned bytes) {
+		uint64_t value = 0;
+		for (unsigned i = 0; i < bytes; i++) {
+			value |= static_cast<uint64_t>(byte()) << (8 * i);
+		}
+		return value;
+	}
+
+	uint64_t varint() {
+		uint64_t value = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			const uint8_t next = byte();
+			value |= static_cast<uint64_t>(next & 0x7F) << shift;
+			if ((next & 0x80) == 0) {
+				return value;
+			}
+		}
+		m_ok = false;
+		return value;
+	}
+
+	bool ok() const {
+		return m_ok;
+	}
+
+private:
+	const uint8_t* m_data;
+	const uint8_t* m_end;
+	bool m_ok;
+};
+
+SignalColumns::SignalColumns(const DbcParser& parser) {
+	const auto& messages = parser.get_messages();
+	m_first_column.reserve(messages.size());
+	for (const auto& message : messages) {
+		m_first_column.push_back(m_names.size());
+		for (const auto& signal : message.get_signals()) {
+			m_names.push_back(message.name() + "." + signal.name);
+		}
+	}
+}
+
+std::size_t SignalColumns::size() const {
+	return m_names.size();
+}
+
+const std::string& SignalColumns::name(std::size_t column) const {
+	return m_names[column];
+}
+
+std::size_t SignalColumns::first_column(std::size_t message_index) const {
+	return m_first_column[message_index];
+}
+
+ColumnarWriter::ColumnarWriter(const DbcParser& parser, std::ostream& out, ColumnEncoding encoding, std::size_t chunk_size)
+	: m_columns(parser)
+	, m_out(out)
+	, m_encoding(encoding)
+	, m_chunk_size(chunk_size == 0 ? 1 : chunk_size)
+	, m_data(m_columns.size())
+	, m_bytes_written(0) {
+	write_header();
+}
+
+ColumnarWriter::~ColumnarWriter() {
+	flush();
+}
+
+void ColumnarWriter::write_header() {
+	m_buffer.clear();
+	for (char magic : COLUMNAR_MAGIC) {
+		m_buffer.push_back(static_cast<uint8_t>(magic));
+	}
+	m_buffer.push_back(COLUMNAR_VERSION);
+	m_buffer.push_back(static_cast<uint8_t>(m_encoding));
+	put_u32(m_buffer, static_cast<uint32_t>(m_columns.size()));
+	for (std::size_t i = 0; i < m_columns.size(); i++) {
+		const auto& name = m_columns.name(i);
+		const auto size = std::min<std::size_t>(name.size(), UINT16_MAX);
+		put_u16(m_buffer, static_cast<uint16_t>(size));
+		m_buffer.insert(m_buffer.end(), name.begin(), name.begin() + static_cast<std::ptrdiff_t>(size));
+	}
+	m_out.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+	m_bytes_written += m_buffer.size();
+}
+
+void ColumnarWriter::write(std::size_t message_index, uint64_t timestamp_ns, const double* values, std::size_t count) {
+	const auto first = m_columns.first_column(message_index);
+	for (std::size_t i = 0; i < count; i++) {
+		auto& column = m_data[first + i];
+		column.timestamps.push_back(timestamp_ns);
+		column.values.push_back(values[i]);
+		if (column.values.size() >= m_chunk_size) {
+			write_chunk(first + i);
+		}
+	}
+}
+
+void ColumnarWriter::write(const Frame* frames, const BatchResult& result) {
+	for (const auto& decoded : result.frames) {
+		if (decoded.status == Message::ParseSignalsStatus::Success) {
+			write(decoded.message_index, frames[decoded.frame_index].timestamp_ns, result.values.data() + decoded.first_value, decoded.value_count);
+		}
+	}
+}
+
+void ColumnarWriter::write(const std::vector<Frame>& frames, const BatchResult& result) {
+	write(frames.data(), result);
+}
+
+void ColumnarWriter::write_chunk(std::size_t column) {
+	auto& data = m_data[column];
+	const auto samples = data.values.size();
+
+	m_buffer.clear();
+	m_buffer.resize(CHUNK_HEADER_SIZE);
+	if (m_encoding == ColumnEncoding::Plain) {
+		for (auto timestamp : data.timestamps) {
+			put_u64(m_buffer, timestamp);
+		}
+		for (auto value : data.values) {
+			put_u64(m_buffer, double_bits(value));
+		}
+	} else {
+		// Periodic messages have a near constant delta, so the change of the delta is stored.
+		// Zigzag keeps small negative changes small as well.
+		uint64_t previous_timestamp = 0;
+		uint64_t previous_delta = 0;
+		for (auto timestamp : data.timestamps) {
+			const uint64_t delta = timestamp - previous_timestamp;
+			const auto change = static_cast<int64_t>(delta - previous_delta);
+			put_varint(m_buffer, (static_cast<uint64_t>(change) << 1) ^ static_cast<uint64_t>(change >> 63));
+			previous_timestamp = timestamp;
+			previous_delta = delta;
+		}
+		uint64_t previous_bits = 0;
+		for (auto value : data.values) {
+			const auto bits = double_bits(value);
+			uint64_t changed = bits ^ previous_bits;
+			previous_bits = bits;
+
+			unsigned leading = 0;
+			while (leading < 8 && (changed >> (56 - 8 * leading)) == 0) {
+				leading++;
+			}
+			unsigned trailing = 0;
+			while (leading + trailing < 8 && ((changed >> (8 * trailing)) & 0xFF) == 0) {
+				trailing++;
+			}
+			m_buffer.push_back(static_cast<uint8_t>((leading << 4) | trailing));
+			changed >>= 8 * trailing;
+			for (unsigned i = leading + trailing; i < 8; i++) {
+				m_buffer.push_back(static_cast<uint8_t>(changed));
+				changed >>= 8;
+			}
+		}
+	}
+
+	const auto payload = static_cast<uint32_t>(m_buffer.size() - CHUNK_HEADER_SIZE);
+	const uint32_t header[] = {static_cast<uint32_t>(column), static_cast<uint32_t>(samples), payload};
+	for (std::size_t i = 0; i < CHUNK_HEADER_SIZE; i++) {
+		m_buffer[i] = static_cast<uint8_t>(header[i / 4] >> (8 * (i % 4)));
+	}
+	m_out.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+	m_bytes_written += m_buffer.size();
+
+	data.timestamps.clear();
+	data.values.clear();
+}
+
+void ColumnarWriter::flush() {
+	for (std::size_t column = 0; column < m_data.size(); column++) {
+		if (!m_data[column].values.empty()) {
+			write_chunk(column);
+		}
+	}
+	m_out.flush();
+}
+
+std::size_t ColumnarWriter::bytes_written() const {
+	return m_bytes_written;
+}
+
+bool ColumnarReader::read(std::istream& in) {
+	m_columns.clear();
+
+	char magic[sizeof(COLUMNAR_MAGIC)];
+	uint8_t header[6];
+	if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, COLUMNAR_MAGIC, sizeof(magic)) != 0 || !in.read(reinterpret_cast<char*>(header), sizeof(header))
+		|| header[0] != COLUMNAR_VERSION || header[1] > static_cast<uint8_t>(ColumnEncoding::Compressed)) {
+		return false;
+	}
+	const auto encoding = static_cast<ColumnEncoding>(header[1]);
+	const auto column_count = ChunkReader(header + 2, 4).fixed(4);
+
+	for (uint64_t i = 0; i < column_count; i++) {
+		uint8_t size[2];
+		if (!in.read(reinterpret_cast<char*>(size), sizeof(size))) {
+			return false;
+		}
+		Column column;
+		column.name.resize(static_cast<std::size_t>(size[0] | (size[1] << 8)));
+		if (!in.read(&column.name[0], static_cast<std::streamsize>(column.name.size()))) {
+			return false;
+		}
+		m_columns.push_back(column);
+	}
+
+	std::vector<uint8_t> payload;
+	uint8_t chunk_header[CHUNK_HEADER_SIZE];
+	while (in.read(reinterpret_cast<char*>(chunk_header), sizeof(chunk_header))) {
+		ChunkReader header_reader(chunk_header, sizeof(chunk_header));
+		const auto column_index = header_reader.fixed(4);
+		const auto samples = header_reader.fixed(4);
+		payload.resize(static_cast<std::size_t>(header_reader.fixed(4)));
+		if (column_index >= m_columns.size() || !in.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size()))) {
+			return false;
+		}
+		// Checked before decoding, a corrupt count would otherwise grow the column far past the payload
+		const uint64_t payload_size = payload.size();
+		if (encoding == ColumnEncoding::Plain ? payload_size != 16 * samples : payload_size < 2 * samples) {
+			return false;
+		}
+
+		auto& column = m_columns[static_cast<std::size_t>(column_index)];
+		ChunkReader reader(payload.data(), payload.size());
+		if (encoding == ColumnEncoding::Plain) {
+			for (uint64_t i = 0; i < samples; i++) {
+				column.timestamps.push_back(reader.fixed(8));
+			}
+			for (uint64_t i = 0; i < samples; i++) {
+				column.values.push_back(bits_double(reader.fixed(8)));
+			}
+		} else {
+			uint64_t timestamp = 0;
+			uint64_t delta = 0;
+			for (uint64_t i = 0; i < samples; i++) {
+				const auto zigzag = reader.varint();
+				delta += (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+				timestamp += delta;
+				column.timestamps.push_back(timestamp);
+			}
+			uint64_t bits = 0;
+			for (uint64_t i = 0; i < samples; i++) {
+				const auto control = reader.byte();
+				const unsigned leading = control >> 4;
+				const unsigned trailing = control & 0x0F;
+				if (leading + trailing > 8) {
+					return false;
+				}
+				const auto changed = reader.fixed(8 - leading - trailing);
+				bits ^= trailing < 8 ? changed << (8 * trailing) : 0;
+				column.values.push_back(bits_double(bits));
+			}
+		}
+		if (!reader.ok()) {
+			return false;
+		}
+	}
+	// Only a clean end between chunks counts, a partial chunk header means the stream was cut short
+	return in.eof() && in.gcount() == 0;
+}
+
+const std::vector<ColumnarReader::Column>& ColumnarReader::columns() const {
+	return m_columns;
+}
+
+CsvWriter::CsvWriter(const DbcParser& parser, std::ostream& out, std::size_t buffer_size)
+	: m_columns(parser)
+	, m_out(out)
+	, m_buffer(std::max<std::size_t>(buffer_size, 256))
+	, m_used(0) {
+	const char header[] = "timestamp_ns,signal,value\n";
+	append(header, sizeof(header) - 1);
+}
+
+CsvWriter::~CsvWriter() {
+	flush();
+}
+
+void CsvWriter::append(const char* data, std::size_t size) {
+	if (m_used + size > m_buffer.size()) {
+		flush();
+		if (size > m_buffer.size()) {
+			m_out.write(data, static_cast<std::streamsize>(size));
+			return;
+		}
+	}
+	std::memcpy(m_buffer.data() + m_used, data, size);
+	m_used += size;
+}
+
+void CsvWriter::write(std::size_t message_index, uint64_t timestamp_ns, const double* values, std::size_t count) {
+	// The timestamp is the same for the whole message, format it once
+	char timestamp[24];
+	std::size_t timestamp_size = 0;
+	do {
+		timestamp[timestamp_size++] = static_cast<char>('0' + timestamp_ns % 10);
+		timestamp_ns /= 10;
+	} while (timestamp_ns != 0);
+	std::reverse(timestamp, timestamp + timestamp_size);
+	timestamp[timestamp_size++] = ',';
+
+	const auto first = m_columns.first_column(message_index);
+	char value[Utils::String::FORMAT_DOUBLE_SIZE + 1];
+	for (std::size_t i = 0; i < count; i++) {
+		const auto& name = m_columns.name(first + i);
+		auto value_size = Utils::String::format_double(values[i], value + 1);
+		value[0] = ',';
+		value[++value_size] = '\n';
+		value_size++;
+
+		append(timestamp, timestamp_size);
+		append(name.data(), name.size());
+		append(value, value_size);
+	}
+}
+
+void CsvWriter::write(const Frame* frames, const BatchResult& result) {
+	for (const auto& decoded : result.frames) {
+		if (decoded.status == Message::ParseSignalsStatus::Success) {
+			write(decoded.message_index, frames[decoded.frame_index].timestamp_ns, result.values.data() + decoded.first_value, decoded.value_count);
+		}
+	}
+}
+
+void CsvWriter::write(const std::vector<Frame>& frames, const BatchResult& result) {
+	write(frames.data(), result);
+}
+
+void CsvWriter::flush() {
+	if (m_used > 0) {
+		m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+		m_used = 0;
+	}
+	m_out.flush();
+}
+
+}
@@ -0,0 +1,178 @@
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_observer.hpp>
+#include <libdbc/signal_statistics.hpp>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Libdbc {
+
+constexpr std::size_t SignalStatistics::DEFAULT_BUCKET_COUNT;
+
+static uint64_t next_statistics_instance_id() {
+	static std::atomic<uint64_t> next_id{1};
+	return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+SignalStatistics::SignalStatistics(const DbcParser& parser, std::size_t bucket_count)
+	: m_instance_id(next_statistics_instance_id())
+	, m_total_buckets(0) {
+	for (const auto& message : parser.get_messages()) {
+		m_message_offsets.push_back(m_layouts.size());
+		for (const auto& signal : message.get_signals()) {
+			Layout layout{m_total_buckets, 0, signal.min, 0};
+			if (bucket_count > 0 && signal.max > signal.min) {
+				layout.bucket_count = bucket_count;
+				layout.bucket_width = (signal.max - signal.min) / static_cast<double>(bucket_count);
+			}
+			m_total_buckets += layout.bucket_count;
+			m_layouts.push_back(layout);
+		}
+	}
+}
+
+SignalStatistics::Shard& SignalStatistics::local_shard() {
+	// Remember the last instance this thread wrote to so the common case skips the lock
+	thread_local uint64_t cached_instance = 0;
+	thread_local Shard* cached_shard = nullptr;
+	if (cached_instance == m_instance_id) {
+		return *cached_shard;
+	}
+
+	std::lock_guard<std::mutex> lock(m_shards_mutex);
+	auto& shard = m_shard_by_thread[std::this_thread::get_id()];
+	if (shard == nullptr) {
+		m_shards.emplace_back(new Shard());
+		shard = m_shards.back().get();
+		shard->accumulators.assign(m_layouts.size(), Accumulator{0, 0, 0, 0, 0, 0, 0});
+		shard->buckets.assign(m_total_buckets, 0);
+	}
+
+	cached_instance = m_instance_id;
+	cached_shard = shard;
+	return *shard;
+}
+
+void SignalStatistics::on_decoded(const DecodedMessage& decoded) {
+	if (decoded.message_index >= m_message_offsets.size()) {
+		return;
+	}
+
+	auto& shard = local_shard();
+	std::lock_guard<std::mutex> lock(shard.mutex); // Only contended while summary() merges
+
+	const auto first = m_message_offsets[decoded.message_index];
+	const auto last = (decoded.message_index + 1 < m_message_offsets.size()) ? m_message_offsets[decoded.message_index + 1] : m_layouts.size();
+	const auto count = (last - first) < decoded.value_count ? (last - first) : decoded.value_count;
+
+	for (std::size_t i = 0; i < count; i++) {
+		const double value = decoded.values[i];
+		const auto& layout = m_layouts[first + i];
+		auto& acc = shard.accumulators[first + i];
+
+		// Welford's online update
+		acc.count++;
+		const double delta = value - acc.mean;
+		acc.mean += delta / static_cast<double>(acc.count);
+		acc.m2 += delta * (value - acc.mean);
+		if (acc.count == 1 || value < acc.min) {
+			acc.min = value;
+		}
+		if (acc.count == 1 || value > acc.max) {
+			acc.max = value;
+		}
+
+		if (layout.bucket_count == 0) {
+			continue;
+		}
+		const double position = (value - layout.histogram_min) / layout.bucket_width;
+		if (position < 0) {
+			acc.underflow++;
+		} else if (position >= static_cast<double>(layout.bucket_count)) {
+			// The upper limit itself still belongs to the last bucket
+			if (value <= layout.histogram_min + layout.bucket_width * static_cast<double>(layout.bucket_count)) {
+				shard.buckets[layout.first_bucket + layout.bucket_count - 1]++;
+			} else {
+				acc.overflow++;
+			}
+		} else {
+			shard.buckets[layout.first_bucket + static_cast<std::size_t>(position)]++;
+		}
+	}
+}
+
+std::size_t SignalStatistics::slot_for(const SignalHandle& handle) const {
+	if (handle.message_index >= m_message_offsets.size()) {
+		return m_layouts.size();
+	}
+
+	// A signal index past the message's end would land on the next message's slots
+	const auto first = m_message_offsets[handle.message_index];
+	const auto last = (handle.message_index + 1 < m_message_offsets.size()) ? m_message_offsets[handle.message_index + 1] : m_layouts.size();
+	if (handle.signal_index >= last - first) {
+		return m_layouts.size();
+	}
+	return first + handle.signal_index;
+}
+
+SignalStatistics::Summary SignalStatistics::summary(const SignalHandle& handle) const {
+	Summary summary{0, 0, 0, 0, 0, 0, 0, 0, {}, 0, 0};
+
+	const auto slot = slot_for(handle);
+	if (slot >= m_layouts.size()) {
+		return summary;
+	}
+
+	const auto& layout = m_layouts[slot];
+	summary.histogram_min = layout.histogram_min;
+	summary.bucket_width = layout.bucket_width;
+	summary.buckets.assign(layout.bucket_count, 0);
+
+	double m2 = 0;
+	std::lock_guard<std::mutex> lock(m_shards_mutex);
+	for (const auto& shard : m_shards) {
+		std::lock_guard<std::mutex> shard_lock(shard->mutex);
+		const auto& acc = shard->accumulators[slot];
+		if (acc.count == 0) {
+			continue;
+		}
+
+		// Chan et al. pairwise combination of the running moments
+		const auto total = summary.count + acc.count;
+		const double delta = acc.mean - summary.mean;
+		m2 += acc.m2 + delta * delta * static_cast<double>(summary.count) * static_cast<double>(acc.count) / static_cast<double>(total);
+		summary.mean += delta * static_cast<double>(acc.count) / static_cast<double>(total);
+
+		summary.min = (summary.count == 0 || acc.min < summary.min) ? acc.min : summary.min;
+		summary.max = (summary.count == 0 || acc.max > summary.max) ? acc.max : summary.max;
+		summary.count = total;
+		summary.underflow += acc.underflow;
+		summary.overflow += acc.overflow;
+
+		for (std::size_t i = 0; i < layout.bucket_count; i++) {
+			summary.buckets[i] += shard->buckets[layout.first_bucket + i];
+		}
+	}
+
+	if (summary.count > 0) {
+		summary.variance = m2 / static_cast<double>(summary.count);
+		summary.stddev = std::sqrt(summary.variance);
+	}
+	return summary;
+}
+
+void SignalStatistics::reset() {
+	std::lock_guard<std::mutex> lock(m_shards_mutex);
+	for (auto& shard : m_shards) {
+		std::lock_guard<std::mutex> shard_lock(shard->mutex);
+		shard->accumulators.assign(m_layouts.size(), Accumulator{0, 0, 0, 0, 0, 0, 0});
+		shard->buckets.assign(m_total_buckets, 0);
+	}
+}
+
+}
@@ -0,0 +1,134 @@
+#include <cstddef>
+#include <functional>
+#include <libdbc/string_pool.hpp>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace Libdbc {
+
+InternedString::InternedString(const std::string& value)
+	: m_value(std::make_shared<const std::string>(value)) {
+}
+
+InternedString::InternedString(const char* value)
+	: m_value(std::make_shared<const std::string>(value)) {
+}
+
+InternedString::InternedString(std::shared_ptr<const std::string> value)
+	: m_value(std::move(value)) {
+}
+
+const std::string& InternedString::str() const {
+	static const std::string empty_string;
+	return m_value ? *m_value : empty_string;
+}
+
+const char* InternedString::c_str() const {
+	return str().c_str();
+}
+
+std::size_t InternedString::size() const {
+	return str().size();
+}
+
+bool InternedString::empty() const {
+	return str().empty();
+}
+
+int InternedString::compare(const std::string& other) const {
+	return str().compare(other);
+}
+
+InternedString::operator const std::string&() const {
+	return str();
+}
+
+bool InternedString::operator==(const InternedString& rhs) const {
+	// Handles from the same pool share storage, only fall back to the text for mixed origins
+	return (m_value == rhs.m_value) || (str() == rhs.str());
+}
+
+bool InternedString::operator!=(const InternedString& rhs) const {
+	return !(*this == rhs);
+}
+
+bool operator==(const InternedString& lhs, const std::string& rhs) {
+	return lhs.str() == rhs;
+}
+
+bool operator==(const std::string& lhs, const InternedString& rhs) {
+	return lhs == rhs.str();
+}
+
+bool operator!=(const InternedString& lhs, const std::string& rhs) {
+	return !(lhs == rhs);
+}
+
+bool operator!=(const std::string& lhs, const InternedString& rhs) {
+	return !(lhs == rhs);
+}
+
+bool operator==(const InternedString& lhs, const char* rhs) {
+	return lhs.str() == rhs;
+}
+
+bool operator!=(const InternedString& lhs, const char* rhs) {
+	return !(lhs == rhs);
+}
+
+std::ostream& operator<<(std::ostream& out, const InternedString& str) {
+	return out << str.str();
+}
+
+std::size_t StringPool::Hash::operator()(const std::shared_ptr<const std::string>& value) const {
+	return std::hash<std::string>()(*value);
+}
+
+bool StringPool::Equal::operator()(const std::shared_ptr<const std::string>& lhs, const std::shared_ptr<const std::string>& rhs) const {
+	return *lhs == *rhs;
+}
+
+InternedString StringPool::intern(const std::string& value) {
+	return intern(value.data(), value.size());
+}
+
+InternedString StringPool::intern(const char* data, std::size_t size) {
+	// Reuse one lookup buffer so a hit never allocates. The key only aliases it, it doesn't own it.
+	m_lookup.assign(data, size);
+	const std::shared_ptr<const std::string> key(std::shared_ptr<const std::string>(), &m_lookup);
+
+	auto found = m_strings.find(key);
+	if (found != m_strings.end()) {
+		return InternedString(*found);
+	}
+
+	auto inserted = m_strings.insert(std::make_shared<const std::string>(m_lookup));
+	return InternedString(*inserted.first);
+}
+
+std::size_t StringPool::size() const {
+	return m_strings.size();
+}
+
+void StringPool::clear() {
+	m_strings.clear();
+}
+
+std::size_t StringPool::memory_bytes() const {
+	std::size_t bytes = m_strings.bucket_count() * sizeof(void*);
+	for (const auto& value : m_strings) {
+		// Table node plus the make_shared block holding the string and its reference counts
+		bytes += sizeof(void*) + sizeof(value) + sizeof(std::string) + 2 * sizeof(long);
+
+		const char* object = reinterpret_cast<const char*>(value.get());
+		const bool is_inline = value->data() >= object && value->data() < object + sizeof(std::string);
+		if (!is_inline) {
+			bytes += value->capacity() + 1;
+		}
+	}
+	return bytes;
+}
+
+}
@@ -0,0 +1,119 @@
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_plan.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/subscriptions.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Libdbc {
+
+constexpr std::size_t MAX_CLASSIC_PAYLOAD = 8;
+
+SignalSubscriptions::SignalSubscriptions(const DbcParser& parser)
+	: m_parser(parser)
+	, m_active(0) {
+}
+
+SignalSubscriptions::Id SignalSubscriptions::subscribe(const std::string& qualified_name, Callback callback) {
+	return subscribe(m_parser.find_signal_handle(qualified_name), std::move(callback));
+}
+
+SignalSubscriptions::Id SignalSubscriptions::subscribe(const SignalHandle& handle, Callback callback) {
+	const auto& messages = m_parser.get_messages();
+	if (!handle.is_valid() || handle.message_index >= messages.size() || handle.signal_index >= messages[handle.message_index].get_signals().size()) {
+		return invalid_id;
+	}
+
+	const Id id = m_subscriptions.size();
+	m_subscriptions.push_back(Subscription{handle, std::move(callback), true});
+	m_active++;
+	rebuild(handle.message_index);
+	return id;
+}
+
+bool SignalSubscriptions::unsubscribe(Id id) {
+	if (id >= m_subscriptions.size() || !m_subscriptions[id].active) {
+		return false;
+	}
+
+	auto& subscription = m_subscriptions[id];
+	subscription.active = false;
+	subscription.callback = nullptr;
+	m_active--;
+	rebuild(subscription.signal.message_index);
+	return true;
+}
+
+void SignalSubscriptions::rebuild(std::size_t message_index) {
+	const auto& message = m_parser.get_messages()[message_index];
+
+	// Subscribed signals in message order, each with its subscriptions in subscription order
+	std::vector<std::vector<Id>> by_signal(message.get_signals().size());
+	for (Id id = 0; id < m_subscriptions.size(); id++) {
+		const auto& subscription = m_subscriptions[id];
+		if (subscription.active && subscription.signal.message_index == message_index) {
+			by_signal[subscription.signal.signal_index].push_back(id);
+		}
+	}
+
+	std::vector<std::size_t> signal_indices;
+	std::vector<std::size_t> first;
+	std::vector<Id> subscribers;
+	for (std::size_t i = 0; i < by_signal.size(); i++) {
+		if (!by_signal[i].empty()) {
+			signal_indices.push_back(i);
+			first.push_back(subscribers.size());
+			subscribers.insert(subscribers.end(), by_signal[i].begin(), by_signal[i].end());
+		}
+	}
+	first.push_back(subscribers.size());
+
+	m_dispatch.erase(message.id());
+	if (!signal_indices.empty()) {
+		m_dispatch.emplace(message.id(), Dispatch{message_index, DecodePlan(message, signal_indices), first, subscribers});
+		if (m_values.size() < signal_indices.size()) {
+			m_values.resize(signal_indices.size());
+		}
+	}
+
+	// Bits can't be taken out of the filter one by one, refill it from the ids still listened to
+	m_filter.clear();
+	for (const auto& dispatch : m_dispatch) {
+		m_filter.insert(dispatch.first);
+	}
+}
+
+bool SignalSubscriptions::dispatch(const Frame& frame) {
+	if (!m_filter.may_contain(frame.id)) {
+		return false;
+	}
+	auto found = m_dispatch.find(frame.id);
+	if (found == m_dispatch.end()) {
+		return false;
+	}
+
+	const auto& dispatch = found->second;
+	if (frame.size <= MAX_CLASSIC_PAYLOAD) {
+		dispatch.plan.decode(frame.data, frame.size, m_values.data());
+	} else {
+		dispatch.plan.decode_extended(frame.data, frame.size, m_values.data());
+	}
+
+	const auto& signals = dispatch.plan.signals();
+	for (std::size_t i = 0; i < signals.size(); i++) {
+		const SignalUpdate update{SignalHandle(dispatch.message_index, signals[i].signal_index), m_values[i], frame.timestamp_ns};
+		for (auto next = dispatch.first[i]; next < dispatch.first[i + 1]; next++) {
+			m_subscriptions[dispatch.subscribers[next]].callback(update);
+		}
+	}
+	return true;
+}
+
+std::size_t SignalSubscriptions::subscription_count() const {
+	return m_active;
+}
+
+}
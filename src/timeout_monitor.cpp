@@ -0,0 +1,200 @@
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/decode_observer.hpp>
+#include <libdbc/message.hpp>
+#include <libdbc/timeout_monitor.hpp>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Libdbc {
+
+constexpr uint64_t TimeoutMonitor::DEFAULT_TICK_NS;
+constexpr std::size_t TimeoutMonitor::npos;
+constexpr std::size_t TimeoutMonitor::SLOTS;
+
+TimeoutMonitor::TimeoutMonitor(const DbcParser& parser, Callback callback, double cycle_multiplier, uint64_t tick_ns)
+	: m_parser(parser)
+	, m_callback(std::move(callback))
+	, m_tick_ns(tick_ns == 0 ? 1 : tick_ns)
+	, m_started(false)
+	, m_current_tick(0)
+	, m_armed(0)
+	, m_slots(LEVELS * SLOTS, npos) {
+	const auto& messages = parser.get_messages();
+	m_timers.resize(messages.size());
+	for (std::size_t i = 0; i < messages.size(); i++) {
+		auto& timer = m_timers[i];
+		timer.timeout_ns = static_cast<uint64_t>(static_cast<double>(messages[i].cycle_time()) * 1e6 * cycle_multiplier);
+		timer.last_seen_ns = 0;
+		timer.deadline_ns = 0;
+		timer.deadline_tick = 0;
+		timer.slot = npos;
+		timer.prev = npos;
+		timer.next = npos;
+		timer.timed_out = false;
+	}
+}
+
+void TimeoutMonitor::on_decoded(const DecodedMessage& decoded) {
+	if (decoded.message_index >= m_timers.size() || m_timers[decoded.message_index].timeout_ns == 0) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	start(decoded.timestamp_ns / m_tick_ns);
+
+	auto& timer = m_timers[decoded.message_index];
+	timer.last_seen_ns = decoded.timestamp_ns;
+	timer.timed_out = false;
+	arm(decoded.message_index, decoded.timestamp_ns + timer.timeout_ns);
+}
+
+void TimeoutMonitor::arm_all(uint64_t now_ns) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	start(now_ns / m_tick_ns);
+
+	for (std::size_t i = 0; i < m_timers.size(); i++) {
+		if (m_timers[i].timeout_ns != 0) {
+			m_timers[i].timed_out = false;
+			arm(i, now_ns + m_timers[i].timeout_ns);
+		}
+	}
+}
+
+void TimeoutMonitor::advance(uint64_t now_ns) {
+	std::vector<Timeout> expired;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const uint64_t now_tick = now_ns / m_tick_ns;
+		start(now_tick);
+
+		while (m_current_tick < now_tick) {
+			if (m_armed == 0) {
+				m_current_tick = now_tick;
+				break;
+			}
+
+			const uint64_t tick = ++m_current_tick;
+			// Refill the lower levels from the top down whenever a level's digit wraps around
+			for (unsigned level = LEVELS - 1; level > 0; level--) {
+				const uint64_t below = (uint64_t(1) << (SLOT_BITS * level)) - 1;
+				if ((tick & below) == 0) {
+					cascade_slot(level * SLOTS + static_cast<std::size_t>((tick >> (SLOT_BITS * level)) & (SLOTS - 1)));
+				}
+			}
+			expire_slot(static_cast<std::size_t>(tick & (SLOTS - 1)));
+		}
+		expired.swap(m_expired);
+	}
+
+	for (const auto& timeout : expired) {
+		m_callback(timeout);
+	}
+}
+
+bool TimeoutMonitor::is_timed_out(std::size_t message_index) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return message_index < m_timers.size() && m_timers[message_index].timed_out;
+}
+
+std::size_t TimeoutMonitor::armed_count() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_armed;
+}
+
+void TimeoutMonitor::start(uint64_t tick) {
+	if (!m_started) {
+		m_started = true;
+		m_current_tick = tick;
+	}
+}
+
+void TimeoutMonitor::arm(std::size_t index, uint64_t deadline_ns) {
+	auto& timer = m_timers[index];
+	const uint64_t deadline_tick = (deadline_ns + m_tick_ns - 1) / m_tick_ns;
+	timer.deadline_ns = deadline_ns;
+
+	if (timer.slot == npos) {
+		timer.deadline_tick = deadline_tick;
+		schedule(index, m_current_tick + 1);
+		m_armed++;
+	} else if (deadline_tick < timer.deadline_tick) {
+		// Only an earlier deadline needs to move the timer
+		unlink(index);
+		timer.deadline_tick = deadline_tick;
+		schedule(index, m_current_tick + 1);
+	} else {
+		// A later one is picked up when the timer's slot comes around, which keeps arrivals cheap
+		timer.deadline_tick = deadline_tick;
+	}
+}
+
+void TimeoutMonitor::schedule(std::size_t index, uint64_t earliest_tick) {
+	auto& timer = m_timers[index];
+	const uint64_t tick = timer.deadline_tick < earliest_tick ? earliest_tick : timer.deadline_tick;
+
+	// The level is picked by the highest digit where the deadline differs from the current tick,
+	// so the slot is always reached, and cascaded down, before the deadline.
+	const uint64_t diff = tick ^ m_current_tick;
+	unsigned level = 0;
+	while (level + 1 < LEVELS && (diff >> (SLOT_BITS * (level + 1))) != 0) {
+		level++;
+	}
+
+	const std::size_t slot = level * SLOTS + static_cast<std::size_t>((tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+	timer.slot = slot;
+	timer.prev = npos;
+	timer.next = m_slots[slot];
+	if (timer.next != npos) {
+		m_timers[timer.next].prev = index;
+	}
+	m_slots[slot] = index;
+}
+
+void TimeoutMonitor::unlink(std::size_t index) {
+	auto& timer = m_timers[index];
+	if (timer.prev != npos) {
+		m_timers[timer.prev].next = timer.next;
+	} else {
+		m_slots[timer.slot] = timer.next;
+	}
+	if (timer.next != npos) {
+		m_timers[timer.next].prev = timer.prev;
+	}
+	timer.slot = npos;
+}
+
+std::size_t TimeoutMonitor::detach(std::size_t slot) {
+	const std::size_t head = m_slots[slot];
+	m_slots[slot] = npos;
+	return head;
+}
+
+void TimeoutMonitor::expire_slot(std::size_t slot) {
+	for (std::size_t index = detach(slot); index != npos;) {
+		auto& timer = m_timers[index];
+		const std::size_t next = timer.next;
+
+		if (timer.deadline_tick <= m_current_tick) {
+			timer.slot = npos;
+			timer.timed_out = true;
+			m_armed--;
+			m_expired.push_back(Timeout{&m_parser.get_messages()[index], index, timer.last_seen_ns, timer.deadline_ns});
+		} else {
+			schedule(index, m_current_tick + 1);
+		}
+		index = next;
+	}
+}
+
+void TimeoutMonitor::cascade_slot(std::size_t slot) {
+	for (std::size_t index = detach(slot); index != npos;) {
+		const std::size_t next = m_timers[index].next;
+		schedule(index, m_current_tick);
+		index = next;
+	}
+}
+
+}
@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/transport.hpp>
+#include <vector>
+
+namespace Libdbc {
+
+constexpr std::size_t TransportReassembler::MAX_PAYLOAD;
+constexpr std::size_t TransportReassembler::npos;
+constexpr uint64_t TransportReassembler::EMPTY_KEY;
+
+constexpr uint32_t MAX_STANDARD_ID = 0x7FF;
+constexpr std::size_t CLASSIC_FRAME_SIZE = 8;
+
+// ISO-TP protocol control information, the high nibble of the first byte
+constexpr unsigned ISOTP_SINGLE_FRAME = 0;
+constexpr unsigned ISOTP_FIRST_FRAME = 1;
+constexpr unsigned ISOTP_CONSECUTIVE_FRAME = 2;
+
+// J1939-21 transport PDU formats and connection management control bytes
+constexpr uint32_t J1939_TP_CM = 0xEC;
+constexpr uint32_t J1939_TP_DT = 0xEB;
+constexpr uint8_t J1939_RTS = 16;
+constexpr uint8_t J1939_BAM = 32;
+constexpr uint8_t J1939_ABORT = 255;
+constexpr std::size_t J1939_MAX_PAYLOAD = 1785;
+constexpr std::size_t J1939_PACKET_DATA = 7;
+
+// Keeps the keys of both protocols apart in the session table
+constexpr uint64_t ISOTP_KEY = 1ULL << 40;
+constexpr uint64_t J1939_KEY = 2ULL << 40;
+
+static uint64_t j1939_key(uint8_t source, uint8_t destination) {
+	return J1939_KEY | (static_cast<uint64_t>(source) << 8) | destination;
+}
+
+TransportReassembler::TransportReassembler(const TransportOptions& options)
+	: m_options(options)
+	, m_j1939(false)
+	, m_sessions(options.max_sessions)
+	, m_buffers(options.max_sessions * MAX_PAYLOAD)
+	, m_completed(npos)
+	, m_mask(0)
+	, m_active(0)
+	, m_dropped(0) {
+	m_free.reserve(m_sessions.size());
+	for (std::size_t i = m_sessions.size(); i > 0; i--) {
+		m_sessions[i - 1].key = EMPTY_KEY;
+		m_free.push_back(i - 1);
+	}
+
+	std::size_t buckets = 2;
+	while (buckets < 2 * m_sessions.size()) {
+		buckets *= 2;
+	}
+	m_keys.assign(buckets, EMPTY_KEY);
+	m_values.assign(buckets, npos);
+	m_mask = buckets - 1;
+}
+
+void TransportReassembler::add_isotp_id(uint32_t id) {
+	m_isotp_filter.insert(id);
+	m_isotp_ids.insert(id);
+}
+
+void TransportReassembler::enable_j1939(bool enable) {
+	m_j1939 = enable;
+}
+
+bool TransportReassembler::feed(const Frame& frame, Transfer& completed) {
+	if (m_completed != npos) {
+		m_free.push_back(m_completed);
+		m_active--;
+		m_completed = npos;
+	}
+
+	if (m_j1939 && frame.id > MAX_STANDARD_ID) {
+		const uint32_t format = (frame.id >> 16) & 0xFF;
+		if (format == J1939_TP_CM || format == J1939_TP_DT) {
+			return feed_j1939(frame, completed);
+		}
+	}
+	if (m_isotp_filter.may_contain(frame.id) && m_isotp_ids.count(frame.id) != 0) {
+		return feed_isotp(frame, completed);
+	}
+	return false;
+}
+
+bool TransportReassembler::feed_isotp(const Frame& frame, Transfer& completed) {
+	if (frame.size < 2) {
+		return false;
+	}
+
+	const uint8_t* data = frame.data;
+	const uint64_t key = ISOTP_KEY | frame.id;
+	switch (data[0] >> 4) {
+	case ISOTP_SINGLE_FRAME: {
+		const std::size_t size = data[0] & 0x0F;
+		if (size == 0 || size > frame.size - 1) {
+			return false;
+		}
+		// Nothing to reassemble, the payload is handed out in place
+		completed = Transfer{TransportProtocol::IsoTp, frame.id, 0, 0, data + 1, size, frame.timestamp_ns};
+		return true;
+	}
+	case ISOTP_FIRST_FRAME: {
+		const std::size_t size = (static_cast<std::size_t>(data[0] & 0x0F) << 8) | data[1];
+		if (size < CLASSIC_FRAME_SIZE) {
+			return false; // would have fit into a single frame
+		}
+		const auto restarted = find(key);
+		if (restarted != npos) {
+			close(restarted);
+			m_dropped++;
+		}
+		const auto session = open(key, frame);
+		if (session == npos) {
+			return false;
+		}
+		m_sessions[session].protocol = TransportProtocol::IsoTp;
+		m_sessions[session].size = size;
+		m_sessions[session].next_sequence = 1;
+		return append(session, data + 2, frame.size - 2, frame, completed);
+	}
+	case ISOTP_CONSECUTIVE_FRAME: {
+		const auto session = find(key);
+		if (session == npos) {
+			return false;
+		}
+		auto& state = m_sessions[session];
+		if ((data[0] & 0x0F) != state.next_sequence) {
+			close(session);
+			m_dropped++;
+			return false;
+		}
+		state.next_sequence = static_cast<uint8_t>((state.next_sequence + 1) & 0x0F);
+		return append(session, data + 1, frame.size - 1, frame, completed);
+	}
+	default:
+		return false; // flow control is for the sender
+	}
+}
+
+bool TransportReassembler::feed_j1939(const Frame& frame, Transfer& completed) {
+	if (frame.size < CLASSIC_FRAME_SIZE) {
+		return false;
+	}
+
+	const uint8_t* data = frame.data;
+	const auto destination = static_cast<uint8_t>(frame.id >> 8);
+	const auto source = static_cast<uint8_t>(frame.id);
+	const uint64_t key = j1939_key(source, destination);
+
+	if (((frame.id >> 16) & 0xFF) == J1939_TP_CM) {
+		if (data[0] == J1939_BAM || data[0] == J1939_RTS) {
+			const std::size_t size = data[1] | (static_cast<std::size_t>(data[2]) << 8);
+			if (size <= CLASSIC_FRAME_SIZE || size > J1939_MAX_PAYLOAD) {
+				return false;
+			}
+			const auto restarted = find(key);
+			if (restarted != npos) {
+				close(restarted);
+				m_dropped++;
+			}
+			const auto session = open(key, frame);
+			if (session == npos) {
+				return false;
+			}
+			auto& state = m_sessions[session];
+			state.protocol = TransportProtocol::J1939;
+			state.id = data[5] | (static_cast<uint32_t>(data[6]) << 8) | (static_cast<uint32_t>(data[7]) << 16);
+			state.source = source;
+			state.destination = destination;
+			state.size = size;
+			state.next_sequence = 1;
+		} else if (data[0] == J1939_ABORT) {
+			// Either side of a connection can abort it
+			const uint64_t keys[] = {key, j1939_key(destination, source)};
+			for (auto aborted_key : keys) {
+				const auto session = find(aborted_key);
+				if (session != npos) {
+					close(session);
+					m_dropped++;
+				}
+			}
+		}
+		return false; // clear to send and acknowledgements only matter to the two nodes
+	}
+
+	const auto session = find(key);
+	if (session == npos) {
+		return false;
+	}
+	auto& state = m_sessions[session];
+	const uint8_t sequence = data[0];
+	if (sequence == 0 || sequence > state.next_sequence) {
+		close(session);
+		m_dropped++;
+		return false;
+	}
+	// A repeated packet was requested again by a clear to send, the transfer continues from there
+	state.received = (sequence - 1u) * J1939_PACKET_DATA;
+	state.next_sequence = static_cast<uint8_t>(sequence + 1);
+	return append(session, data + 1, J1939_PACKET_DATA, frame, completed);
+}
+
+std::size_t TransportReassembler::open(uint64_t key, const Frame& frame) {
+	if (m_free.empty()) {
+		m_dropped++;
+		return npos;
+	}
+	const auto session = m_free.back();
+	m_free.pop_back();
+	m_active++;
+
+	auto& state = m_sessions[session];
+	state = Session{key, TransportProtocol::IsoTp, frame.id, 0, 0, 0, 0, 0, frame.timestamp_ns};
+
+	auto index = bucket(key);
+	while (m_keys[index] != EMPTY_KEY) {
+		index = (index + 1) & m_mask;
+	}
+	m_keys[index] = key;
+	m_values[index] = session;
+	return session;
+}
+
+void TransportReassembler::close(std::size_t session) {
+	erase_key(m_sessions[session].key);
+	m_sessions[session].key = EMPTY_KEY;
+	m_free.push_back(session);
+	m_active--;
+}
+
+bool TransportReassembler::append(std::size_t session, const uint8_t* data, std::size_t size, const Frame& frame, Transfer& completed) {
+	auto& state = m_sessions[session];
+	uint8_t* buffer = m_buffers.data() + session * MAX_PAYLOAD;
+	const std::size_t count = std::min(size, state.size - state.received);
+	std::memcpy(buffer + state.received, data, count);
+	state.received += count;
+	state.last_ns = frame.timestamp_ns;
+	if (state.received < state.size) {
+		return false;
+	}
+
+	completed = Transfer{state.protocol, state.id, state.source, state.destination, buffer, state.size, frame.timestamp_ns};
+	// The key is free for the next transfer right away, the buffer only after the next feed
+	erase_key(state.key);
+	state.key = EMPTY_KEY;
+	m_completed = session;
+	return true;
+}
+
+void TransportReassembler::expire(uint64_t now_ns) {
+	for (std::size_t i = 0; i < m_sessions.size(); i++) {
+		const auto& state = m_sessions[i];
+		if (state.key != EMPTY_KEY && now_ns > state.last_ns && now_ns - state.last_ns > m_options.timeout_ns) {
+			close(i);
+			m_dropped++;
+		}
+	}
+}
+
+std::size_t TransportReassembler::active_sessions() const {
+	return m_completed == npos ? m_active : m_active - 1;
+}
+
+std::size_t TransportReassembler::dropped() const {
+	return m_dropped;
+}
+
+std::size_t TransportReassembler::bucket(uint64_t key) const {
+	return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & m_mask;
+}
+
+std::size_t TransportReassembler::find(uint64_t key) const {
+	for (auto index = bucket(key); m_keys[index] != EMPTY_KEY; index = (index + 1) & m_mask) {
+		if (m_keys[index] == key) {
+			return m_values[index];
+		}
+	}
+	return npos;
+}
+
+void TransportReassembler::erase_key(uint64_t key) {
+	auto index = bucket(key);
+	while (m_keys[index] != key) {
+		if (m_keys[index] == EMPTY_KEY) {
+			return;
+		}
+		index = (index + 1) & m_mask;
+	}
+
+	// Backward shift deletion, moves later entries of the probe run into the gap
+	m_keys[index] = EMPTY_KEY;
+	for (auto next = (index + 1) & m_mask; m_keys[next] != EMPTY_KEY; next = (next + 1) & m_mask) {
+		const auto home = bucket(m_keys[next]);
+		const bool stays = index <= next ? (index < home && home <= next) : (index < home || home <= next);
+		if (stays) {
+			continue;
+		}
+		m_keys[index] = m_keys[next];
+		m_values[index] = m_values[next];
+		m_keys[next] = EMPTY_KEY;
+		index = next;
+	}
+}
+
+}
@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fast_float/fast_float.h>
 #include <istream>
 #include <libdbc/utils/utils.hpp>
@@ -7,10 +12,13 @@
 
 namespace Utils {
 
-std::istream& StreamHandler::get_line(std::istream& stream, std::string& line) {
+std::istream& StreamHandler::get_line(std::istream& stream, std::string& line, std::size_t* line_number) {
 	std::string newline;
 
 	std::getline(stream, newline);
+	if (line_number != nullptr && (stream || !newline.empty())) {
+		++*line_number;
+	}
 
 	// Windows CRLF (\r\n)
 	if (!newline.empty() && newline[newline.size() - 1] == '\r') {
@@ -25,14 +33,14 @@ std::istream& StreamHandler::get_line(std::istream& stream, std::string& line) {
 	return stream;
 }
 
-std::istream& StreamHandler::get_next_non_blank_line(std::istream& stream, std::string& line) {
+std::istream& StreamHandler::get_next_non_blank_line(std::istream& stream, std::string& line, std::size_t* line_number) {
 	bool is_blank = true;
 
 	const std::regex whitespace_re("\\s*(.*)");
 	std::smatch match;
 
 	while (is_blank) {
-		Utils::StreamHandler::get_line(stream, line);
+		Utils::StreamHandler::get_line(stream, line, line_number);
 
 		std::regex_search(line, match, whitespace_re);
 
@@ -46,14 +54,14 @@ std::istream& StreamHandler::get_next_non_blank_line(std::istream& stream, std::
 	return stream;
 }
 
-std::istream& StreamHandler::skip_to_next_blank_line(std::istream& stream, std::string& line) {
+std::istream& StreamHandler::skip_to_next_blank_line(std::istream& stream, std::string& line, std::size_t* line_number) {
 	bool line_is_empty = false;
 
 	const std::regex whitespace_re("\\s*(.*)");
 	std::smatch match;
 
 	while (!line_is_empty) {
-		Utils::StreamHandler::get_line(stream, line);
+		Utils::StreamHandler::get_line(stream, line, line_number);
 
 		std::regex_search(line, match, whitespace_re);
 
@@ -72,6 +80,34 @@ std::string String::trim(const std::string& line) {
 	return start == end ? std::string() : line.substr(start, end - start + 1);
 }
 
+bool String::glob_match(const std::string& pattern, const std::string& text) {
+	std::size_t pat = 0;
+	std::size_t txt = 0;
+	std::size_t star = std::string::npos;
+	std::size_t star_txt = 0;
+
+	while (txt < text.size()) {
+		if (pat < pattern.size() && (pattern[pat] == '?' || pattern[pat] == text[txt])) {
+			pat++;
+			txt++;
+		} else if (pat < pattern.size() && pattern[pat] == '*') {
+			star = pat++;
+			star_txt = txt;
+		} else if (star != std::string::npos) {
+			// Let the last star swallow one more character and retry
+			pat = star + 1;
+			txt = ++star_txt;
+		} else {
+			return false;
+		}
+	}
+
+	while (pat < pattern.size() && pattern[pat] == '*') {
+		pat++;
+	}
+	return pat == pattern.size();
+}
+
 double String::convert_to_double(const std::string& value, double default_value) {
 	double converted_value = default_value;
 	// NOLINTNEXTLINE -- Trying to iterators on the value causes the test to infinitly hang on windows builds
@@ -79,4 +115,95 @@ double String::convert_to_double(const std::string& value, double default_value)
 	return converted_value;
 }
 
+uint64_t String::convert_to_unsigned(const std::string& value, uint64_t default_value) {
+	if (value.empty()) {
+		return default_value;
+	}
+
+	uint64_t converted_value = 0;
+	for (char digit : value) {
+		if (digit < '0' || digit > '9') {
+			return default_value;
+		}
+		const auto next = static_cast<uint64_t>(digit - '0');
+		if (converted_value > (UINT64_MAX - next) / 10) {
+			return default_value;
+		}
+		converted_value = converted_value * 10 + next;
+	}
+	return converted_value;
+}
+
+constexpr std::size_t String::FORMAT_DOUBLE_SIZE;
+
+static std::size_t write_digits(uint64_t value, char* out) {
+	char digits[20];
+	std::size_t count = 0;
+	do {
+		digits[count++] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	std::reverse_copy(digits, digits + count, out);
+	return count;
+}
+
+std::size_t String::format_double(double value, char* out) {
+	if (std::isnan(value)) {
+		std::memcpy(out, "nan", 3);
+		return 3;
+	}
+	if (std::isinf(value)) {
+		std::memcpy(out, value < 0 ? "-inf" : "inf", value < 0 ? 4 : 3);
+		return value < 0 ? 4 : 3;
+	}
+
+	// Decoded values are mostly an integer times a decimal factor, print those as scaled integers
+	static const double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+	constexpr double EXACT_INTEGERS = 9007199254740992.0; // 2^53
+	const double magnitude = std::fabs(value);
+	for (std::size_t decimals = 0; decimals < sizeof(powers_of_ten) / sizeof(powers_of_ten[0]); decimals++) {
+		const double scaled = magnitude * powers_of_ten[decimals];
+		if (scaled >= EXACT_INTEGERS) {
+			break;
+		}
+		// Dividing back is correctly rounded, so when it gives the value the decimal text parses back to it too
+		if (scaled != std::floor(scaled) || scaled / powers_of_ten[decimals] != magnitude) {
+			continue;
+		}
+
+		std::size_t size = 0;
+		if (std::signbit(value)) {
+			out[size++] = '-';
+		}
+		char digits[20];
+		const auto digit_count = write_digits(static_cast<uint64_t>(scaled), digits);
+		if (digit_count <= decimals) {
+			out[size++] = '0';
+			out[size++] = '.';
+			std::memset(out + size, '0', decimals - digit_count);
+			size += decimals - digit_count;
+			std::memcpy(out + size, digits, digit_count);
+			return size + digit_count;
+		}
+		const auto integer_digits = digit_count - decimals;
+		std::memcpy(out + size, digits, integer_digits);
+		size += integer_digits;
+		if (decimals > 0) {
+			out[size++] = '.';
+			std::memcpy(out + size, digits + integer_digits, decimals);
+			size += decimals;
+		}
+		return size;
+	}
+
+	char text[FORMAT_DOUBLE_SIZE];
+	const int written = std::snprintf(text, sizeof(text), "%.17g", value);
+	const auto size = std::min<std::size_t>(written > 0 ? static_cast<std::size_t>(written) : 0, FORMAT_DOUBLE_SIZE);
+	for (std::size_t i = 0; i < size; i++) {
+		// The C locale may use another decimal separator
+		out[i] = (text[i] == ',') ? '.' : text[i];
+	}
+	return size;
+}
+
 } // Namespace Utils
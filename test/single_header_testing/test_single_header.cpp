@@ -18,7 +18,7 @@ TEST_CASE("Testing dbc file loading", "[fileio]") {
 		Libdbc::Signal sig("IO_DEBUG_test_unsigned", false, 0, 8, false, false, 1, 0, 0, 0, "", receivers);
 		msg.append_signal(sig);
 
-		std::vector<Libdbc::Message> msgs = {msg};
+		Libdbc::Vector<Libdbc::Message> msgs = {msg};
 
 		parser->parse_file(SIMPLE_DBC_FILE);
 
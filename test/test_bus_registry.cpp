@@ -0,0 +1,68 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <libdbc/bus_registry.hpp>
+#include <libdbc/parse_result.hpp>
+#include <string>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Bus registry", "[bus_registry]") {
+	std::string powertrain = PRIMITIVE_DBC + R"(BO_ 100 EngineSpeed: 2 Vector__XXX
+ SG_ Rpm : 0|16@1+ (1,0) [0|65535] "rpm" Vector__XXX)";
+	std::string body = PRIMITIVE_DBC + R"(BO_ 100 DoorState: 1 Vector__XXX
+ SG_ Open : 0|8@1+ (2,0) [0|255] "" Vector__XXX)";
+	const auto powertrain_file = create_temporary_dbc_with(powertrain.c_str());
+	const auto powertrain_copy = create_temporary_dbc_with(powertrain.c_str());
+	const auto body_file = create_temporary_dbc_with(body.c_str());
+
+	Libdbc::BusRegistry registry;
+	registry.add_channel(0, powertrain_file);
+	registry.add_channel(1, body_file);
+	registry.add_channel(2, powertrain_copy);
+
+	REQUIRE(registry.load());
+	REQUIRE(registry.channel_count() == 3);
+
+	SECTION("Channels with identical files share one database") {
+		REQUIRE(registry.database_count() == 2);
+		REQUIRE(registry.database(0) == registry.database(2));
+		REQUIRE(registry.database(0) != registry.database(1));
+		REQUIRE(registry.database(3) == nullptr);
+	}
+
+	SECTION("The same id decodes with the definition of its channel") {
+		std::vector<double> values;
+		REQUIRE(registry.decode(0, 100, {0x10, 0x27}, values) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(values == std::vector<double>{10000});
+
+		values.clear();
+		REQUIRE(registry.decode(1, 100, {3}, values) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(values == std::vector<double>{6});
+
+		REQUIRE(registry.find(1, 100)->message->name() == "DoorState");
+		REQUIRE(registry.find(2, 100)->message->name() == "EngineSpeed");
+	}
+
+	SECTION("Unknown channels and ids are reported as unknown") {
+		std::vector<double> values;
+		REQUIRE(registry.decode(5, 100, {0}, values) == Libdbc::Message::ParseSignalsStatus::ErrorUnknownID);
+		REQUIRE(registry.decode(0, 101, {0}, values) == Libdbc::Message::ParseSignalsStatus::ErrorUnknownID);
+		REQUIRE(registry.find(5, 100) == nullptr);
+	}
+
+	SECTION("A failing channel doesn't keep the others from loading") {
+		registry.add_channel(3, std::string(TESTDBCFILES_PATH) + "/MissingVersion.dbc");
+		registry.add_channel(4, TEXT_FILE);
+
+		REQUIRE_FALSE(registry.load(1));
+		REQUIRE(registry.channel_result(3)->error == Libdbc::ParseError::MissingVersion);
+		REQUIRE(registry.channel_result(4)->error == Libdbc::ParseError::NonDbcFileFormat);
+		REQUIRE(registry.channel_result(0)->ok());
+		REQUIRE(registry.channel_result(9) == nullptr);
+		REQUIRE(registry.find(3, 100) == nullptr);
+		REQUIRE(registry.find(0, 100) != nullptr);
+	}
+}
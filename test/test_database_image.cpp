@@ -0,0 +1,174 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <libdbc/database_image.hpp>
+#include <libdbc/dbc.hpp>
+#include <string>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+namespace {
+
+const std::string IMAGE_DBC = PRIMITIVE_DBC + R"(BO_ 300 Body: 8 IO
+ SG_ Angle : 7|16@0- (0.1,-5) [-3200|3200] "deg" DBG
+ SG_ Flag : 20|1@1+ (1,0) [0|1] "" DBG
+BO_ 100 Status: 2 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|255] "%" DBG
+ SG_ Mode : 8|8@1+ (1,0) [0|255] "" DBG
+BO_ 100 Repeated: 1 MOTOR
+ SG_ Other : 0|8@1+ (1,0) [0|255] "" DBG
+BA_ "GenMsgCycleTime" BO_ 300 20;
+)";
+
+Libdbc::DbcParser parse(const std::string& contents) {
+	Libdbc::DbcParser parser;
+	parser.parse_file(create_temporary_dbc_with(contents.c_str()));
+	return parser;
+}
+
+}
+
+TEST_CASE("Database image decodes like the parser", "[database_image]") {
+	auto parser = parse(IMAGE_DBC);
+	const auto image = Libdbc::DatabaseImage::build(parser, 7);
+
+	Libdbc::DatabaseView view;
+	REQUIRE(view.attach(image.data(), image.size()));
+	REQUIRE(view.generation() == 7);
+
+	SECTION("Messages are sorted by id and keep their first definition") {
+		REQUIRE(view.message_count() == 2);
+		REQUIRE(view.message_id(0) == 100);
+		REQUIRE(std::string(view.message_name(0)) == "Status");
+		REQUIRE(view.message_size(0) == 2);
+		REQUIRE(std::string(view.message_name(1)) == "Body");
+		REQUIRE(view.cycle_time(1) == 20);
+		REQUIRE((view.find_message(999) == Libdbc::DatabaseView::npos));
+
+		const auto body = view.find_message(300);
+		REQUIRE(view.signal_count(body) == 2);
+		REQUIRE(std::string(view.signal_name(body, 0)) == "Angle");
+		REQUIRE(std::string(view.signal_unit(body, 0)) == "deg");
+		REQUIRE(view.signals(body)[1].start_bit == 20);
+	}
+
+	SECTION("Values match parse_message") {
+		const std::vector<std::pair<uint32_t, std::vector<uint8_t>>> frames{
+			{100, {12, 3}},
+			{100, {12}},
+			{300, {0xFF, 0x38, 0x10, 0, 0, 0, 0, 0}},
+			{300, {0x01, 0x02}},
+			{999, {1}},
+			{100, {0, 0, 0, 0, 0, 0, 0, 0, 0}},
+		};
+		for (const auto& frame : frames) {
+			std::vector<double> expected;
+			std::vector<double> values;
+			REQUIRE(view.decode(frame.first, frame.second, values) == parser.parse_message(frame.first, frame.second, expected));
+			REQUIRE(values == expected);
+		}
+	}
+}
+
+TEST_CASE("Database image validation", "[database_image]") {
+	auto parser = parse(IMAGE_DBC);
+	auto image = Libdbc::DatabaseImage::build(parser, 1);
+	Libdbc::DatabaseView view;
+
+	SECTION("Truncated images are rejected") {
+		REQUIRE_FALSE(view.attach(image.data(), image.size() - 8));
+		REQUIRE_FALSE(view.attach(image.data(), 16));
+	}
+
+	SECTION("Foreign data is rejected") {
+		image[0] = 'X';
+		REQUIRE_FALSE(view.attach(image.data(), image.size()));
+	}
+
+	SECTION("Unterminated strings are rejected") {
+		std::memset(image.data() + image.size() - 8, 'x', 8);
+		REQUIRE_FALSE(view.attach(image.data(), image.size()));
+	}
+
+	SECTION("Misaligned images are rejected") {
+		std::vector<uint8_t> shifted(image.size() + 1);
+		std::memcpy(shifted.data() + 1, image.data(), image.size());
+		REQUIRE_FALSE(view.attach(shifted.data() + 1, image.size()));
+	}
+
+	SECTION("Plans reaching past 8 bytes are rejected") {
+		REQUIRE(view.attach(image.data(), image.size()));
+		const auto offset = static_cast<std::size_t>(reinterpret_cast<const uint8_t*>(view.signals(0)) - image.data());
+		Libdbc::SignalPlan plan = view.signals(0)[0];
+		view.detach();
+
+		auto attach_with = [&](const Libdbc::SignalPlan& changed) {
+			auto corrupt = image;
+			std::memcpy(corrupt.data() + offset, &changed, sizeof(changed));
+			return view.attach(corrupt.data(), corrupt.size());
+		};
+		REQUIRE(attach_with(plan));
+
+		auto layout = plan;
+		layout.layout = static_cast<Libdbc::SignalPlan::Layout>(99);
+		REQUIRE_FALSE(attach_with(layout));
+		auto size = plan;
+		size.size = 65;
+		REQUIRE_FALSE(attach_with(size));
+		auto start_bit = plan;
+		start_bit.start_bit = 60;
+		REQUIRE_FALSE(attach_with(start_bit));
+		auto bytes = plan;
+		bytes.first_byte = 7;
+		bytes.byte_count = 2;
+		REQUIRE_FALSE(attach_with(bytes));
+	}
+
+	REQUIRE_FALSE(view.is_attached());
+	REQUIRE((view.find_message(100) == Libdbc::DatabaseView::npos));
+}
+
+TEST_CASE("Database images leave out messages longer than 8 bytes", "[database_image]") {
+	auto parser = parse(IMAGE_DBC + R"(BO_ 400 Long: 16 IO
+ SG_ Far : 100|8@1+ (1,0) [0|255] "" DBG
+)");
+	const auto image = Libdbc::DatabaseImage::build(parser, 1);
+	Libdbc::DatabaseView view;
+	REQUIRE(view.attach(image.data(), image.size()));
+	REQUIRE(view.message_count() == 2);
+	REQUIRE((view.find_message(400) == Libdbc::DatabaseView::npos));
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("Published images are mapped and refreshed by generation", "[database_image]") {
+	const std::string path = create_temporary_dbc_with("") + ".dbci";
+	auto parser = parse(IMAGE_DBC);
+	REQUIRE(Libdbc::DatabaseImage::publish(parser, 1, path));
+
+	Libdbc::MappedImage mapped;
+	REQUIRE(mapped.open(path));
+	REQUIRE(mapped.view().generation() == 1);
+	REQUIRE(mapped.view().message_count() == 2);
+	REQUIRE_FALSE(mapped.refresh());
+
+	auto updated = parse(PRIMITIVE_DBC + R"(BO_ 500 Update: 1 IO
+ SG_ Value : 0|8@1+ (2,0) [0|510] "" DBG
+)");
+	REQUIRE(Libdbc::DatabaseImage::publish(updated, 2, path));
+	REQUIRE(mapped.refresh());
+	REQUIRE(mapped.view().generation() == 2);
+
+	std::vector<double> values;
+	REQUIRE(mapped.view().decode(500, {21}, values) == Libdbc::Message::ParseSignalsStatus::Success);
+	REQUIRE(values == std::vector<double>{42});
+	REQUIRE(mapped.view().decode(100, {21}, values) == Libdbc::Message::ParseSignalsStatus::ErrorUnknownID);
+
+	mapped.close();
+	REQUIRE_FALSE(mapped.view().is_attached());
+	std::remove(path.c_str());
+}
+#endif
@@ -13,6 +13,7 @@ using Catch::Matchers::ContainsSubstring;
 TEST_CASE("Testing dbc file loading error issues", "[fileio][error]") {
 	auto parser = std::unique_ptr<Libdbc::DbcParser>(new Libdbc::DbcParser());
 
+#if !defined(DBC_NO_EXCEPTIONS)
 	SECTION("Loading a non dbc file should throw an error", "[error]") {
 		REQUIRE_THROWS_AS(parser->parse_file(TEXT_FILE), Libdbc::NonDbcFileFormatError);
 		REQUIRE_THROWS_WITH(parser->parse_file(TEXT_FILE), ContainsSubstring("TextFile.txt"));
@@ -27,6 +28,7 @@ TEST_CASE("Testing dbc file loading error issues", "[fileio][error]") {
 		REQUIRE_THROWS_AS(parser->parse_file(MISSING_BIT_TIMING_DBC_FILE), Libdbc::DbcFileIsMissingBitTiming);
 		REQUIRE_THROWS_WITH(parser->parse_file(MISSING_BIT_TIMING_DBC_FILE), ContainsSubstring("BU_: DBG DRIVER IO MOTOR SENSOR"));
 	}
+#endif
 
 	SECTION("Loading a dbc with some missing namespace section tags (NS_ :)", "[error]") {
 		// Confusion about this type of error. it appears that the header isn't
@@ -55,7 +57,7 @@ TEST_CASE("Testing dbc file loading", "[fileio]") {
 		Libdbc::Signal sig("IO_DEBUG_test_unsigned", false, 0, 8, false, false, 1, 0, 0, 0, "", receivers);
 		msg.append_signal(sig);
 
-		std::vector<Libdbc::Message> msgs = {msg};
+		Libdbc::Vector<Libdbc::Message> msgs = {msg};
 
 		parser->parse_file(SIMPLE_DBC_FILE);
 
@@ -246,6 +248,25 @@ VAL_ 123 State1 123 "Description 3" 0 "Description 4" ;)";
 	REQUIRE(signal2.value_descriptions.at(1).description == "Description 4");
 }
 
+TEST_CASE("Signal Value Description with repeated message names") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Shared: 8 Vector__XXX
+ SG_ First : 0|8@1+ (1,0) [0|255] "" DBG
+ SG_ Second : 8|8@1+ (1,0) [0|255] "" DBG
+BO_ 200 Shared: 8 Vector__XXX
+ SG_ Second : 0|8@1+ (1,0) [0|255] "" DBG
+ SG_ First : 8|8@1+ (1,0) [0|255] "" DBG
+VAL_ 200 First 1 "On" 0 "Off" ;)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	auto parser = Libdbc::DbcParser();
+	parser.parse_file(filename);
+
+	const auto& signals = parser.find_message(200)->get_signals();
+	REQUIRE(signals.at(0).value_descriptions.empty());
+	REQUIRE(signals.at(1).value_descriptions.size() == 2);
+	REQUIRE(parser.find_message(100)->get_signals().at(0).value_descriptions.empty());
+}
+
 TEST_CASE("Should parse DBC with empty BU_", "[error][optional]") {
 	std::string contents = R"(VERSION ""
 
@@ -309,3 +330,118 @@ BO_ have a issue here:
 	// We could match them all here but i think just a check that the size is sufficent.
 	REQUIRE(unused.size() == 3);
 }
+
+TEST_CASE("Looking up messages and signals without copying", "[lookup]") {
+	std::string contents = PRIMITIVE_DBC + R"(BO_ 293 Msg1: 2 Vector__XXX
+ SG_ Wert7 : 0|16@1- (1,0) [0|0] "" Vector__XXX
+
+BO_ 292 Msg2: 1 Vector__XXX
+ SG_ Wert8 : 0|8@1- (1,0) [0|0] "" Vector__XXX
+ SG_ Wert9 : 0|8@1- (1,0) [0|0] "" Vector__XXX
+)";
+	const auto filename = create_temporary_dbc_with(contents.c_str());
+
+	auto parser = Libdbc::DbcParser();
+	parser.parse_file(filename);
+
+	const auto& messages = parser.get_messages();
+	REQUIRE(&messages == &parser.get_messages());
+
+	SECTION("By id") {
+		REQUIRE(parser.find_message(292) == &messages.at(1));
+		REQUIRE(parser.find_message(1) == nullptr);
+	}
+
+	SECTION("By name") {
+		REQUIRE(parser.find_message("Msg1") == &messages.at(0));
+		REQUIRE(parser.find_message("Msg3") == nullptr);
+
+		const auto* message = parser.find_message("Msg2");
+		REQUIRE(message->find_signal("Wert9") == &message->get_signals().at(1));
+		REQUIRE(message->find_signal("Wert7") == nullptr);
+	}
+
+	SECTION("Parsing again replaces the previous contents") {
+		parser.parse_file(filename);
+		REQUIRE(parser.get_messages().size() == 2);
+		REQUIRE(parser.get_nodes().size() == 5);
+	}
+}
+
+TEST_CASE("Name index and wildcard search", "[lookup]") {
+	std::string contents = PRIMITIVE_DBC + R"(BO_ 100 Engine: 8 MOTOR
+ SG_ EngineSpeed : 0|16@1+ (1,0) [0|8000] "rpm" DBG
+ SG_ EngineTemp : 16|8@1+ (1,-40) [-40|215] "C" DBG
+BO_ 200 Vehicle: 8 SENSOR
+ SG_ VehicleSpeed : 0|16@1+ (0.01,0) [0|300] "km/h" DBG
+VAL_ 100 EngineTemp 0 "Cold" 1 "Warm" ;
+VAL_ 200 Missing 0 "Nothing" ;
+VAL_ 300 EngineTemp 0 "Nothing" ;)";
+	const auto filename = create_temporary_dbc_with(contents.c_str());
+
+	auto parser = Libdbc::DbcParser();
+	parser.parse_file(filename);
+
+	SECTION("Qualified names resolve to handles") {
+		auto handle = parser.find_signal_handle("Engine.EngineTemp");
+		REQUIRE(handle.is_valid());
+		REQUIRE(handle == Libdbc::SignalHandle(0, 1));
+		REQUIRE(parser.get_signal(handle).name == "EngineTemp");
+		REQUIRE(parser.get_signal(handle).value_descriptions.size() == 2);
+
+		REQUIRE_FALSE(parser.find_signal_handle("Engine.VehicleSpeed").is_valid());
+		REQUIRE(parser.find_signal("Vehicle.VehicleSpeed") == &parser.get_messages().at(1).get_signals().at(0));
+		REQUIRE(parser.find_signal("Nope") == nullptr);
+	}
+
+	SECTION("Glob search over signals") {
+		auto speeds = parser.search_signals("*Speed");
+		REQUIRE(speeds.size() == 2);
+		REQUIRE(speeds.at(0) == Libdbc::SignalHandle(0, 0));
+		REQUIRE(speeds.at(1) == Libdbc::SignalHandle(1, 0));
+
+		auto engine = parser.search_signals("Engine.*");
+		REQUIRE(engine.size() == 2);
+
+		REQUIRE(parser.search_signals("Engine.Engine????").size() == 1);
+		REQUIRE(parser.search_signals("Unknown.*").empty());
+	}
+
+	SECTION("Glob search over messages") {
+		auto found = parser.search_messages("*e*");
+		REQUIRE(found.size() == 2);
+		REQUIRE(parser.search_messages("Veh*").at(0)->id() == 200);
+	}
+}
+
+TEST_CASE("Message cycle times", "[parsing]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Fast: 8 Vector__XXX
+ SG_ State1 : 0|8@1+ (1,0) [0|200] "" Vector__XXX
+BO_ 200 Slow: 8 Vector__XXX
+ SG_ State2 : 0|8@1+ (1,0) [0|200] "" Vector__XXX
+BO_ 300 Default: 8 Vector__XXX
+ SG_ State3 : 0|8@1+ (1,0) [0|200] "" Vector__XXX
+BA_DEF_ BO_ "GenMsgCycleTime" INT 0 65535;
+BA_DEF_DEF_ "GenMsgCycleTime" 500;
+BA_ "GenMsgCycleTime" BO_ 100 10;
+BA_ "GenMsgCycleTime" BO_ 200 1000;
+BA_ "GenMsgCycleTime" BO_ 999 20;
+BA_ "FieldType" SG_ 100 State1 "State1";)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	auto parser = Libdbc::DbcParser();
+	parser.parse_file(filename);
+
+	REQUIRE(parser.find_message(100)->cycle_time() == 10);
+	REQUIRE(parser.find_message(200)->cycle_time() == 1000);
+	REQUIRE(parser.find_message(300)->cycle_time() == 500);
+
+	// Only the attribute definition is left over, the unrelated attribute goes to metadata()
+	REQUIRE(parser.unused_lines().size() == 1);
+
+	SECTION("Complex file") {
+		parser.parse_file(std::string(TESTDBCFILES_PATH) + "/Complex.dbc");
+		REQUIRE(parser.find_message(100)->cycle_time() == 1000);
+		REQUIRE(parser.find_message(500)->cycle_time() == 100);
+	}
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/downsampler.hpp>
+#include <string>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+static constexpr uint64_t MS = 1000000;
+
+TEST_CASE("Downsampler", "[downsampler]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Engine: 2 Vector__XXX
+ SG_ Rpm : 0|8@1+ (1,0) [0|255] "" Vector__XXX
+ SG_ Load : 8|8@1+ (1,0) [0|255] "" Vector__XXX)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	std::vector<Libdbc::DownsampledBucket> buckets;
+	Libdbc::Downsampler downsampler(parser, [&buckets](const Libdbc::DownsampledBucket& bucket) {
+		buckets.push_back(bucket);
+	});
+	parser.add_observer(downsampler);
+
+	auto feed = [&parser](uint64_t timestamp_ns, uint8_t rpm) {
+		std::vector<double> values;
+		parser.parse_message(100, {rpm, 0}, values, timestamp_ns);
+	};
+
+	SECTION("Summary buckets") {
+		REQUIRE(downsampler.add_signal("Engine.Rpm"));
+		REQUIRE_FALSE(downsampler.add_signal("Engine.Missing"));
+		REQUIRE_FALSE(downsampler.add_signal(Libdbc::SignalHandle(0, 2)));
+		REQUIRE(downsampler.signal_count() == 1);
+
+		feed(0, 10);
+		feed(40 * MS, 30);
+		feed(80 * MS, 20);
+		REQUIRE(buckets.empty());
+		feed(150 * MS, 5); // closes the first bucket
+		feed(420 * MS, 7); // skips the empty buckets in between
+
+		REQUIRE(buckets.size() == 2);
+		REQUIRE(buckets[0].signal == parser.find_signal_handle("Engine.Rpm"));
+		REQUIRE(buckets[0].start_ns == 0);
+		REQUIRE(buckets[0].count == 3);
+		REQUIRE(buckets[0].first == 10);
+		REQUIRE(buckets[0].last == 20);
+		REQUIRE(buckets[0].min == 10);
+		REQUIRE(buckets[0].max == 30);
+		REQUIRE(buckets[0].mean == 20);
+		REQUIRE(buckets[1].start_ns == 100 * MS);
+		REQUIRE(buckets[1].count == 1);
+
+		downsampler.flush();
+		REQUIRE(buckets.size() == 3);
+		REQUIRE(buckets[2].start_ns == 400 * MS);
+		REQUIRE(buckets[2].last == 7);
+	}
+
+	SECTION("Signals are configured one by one") {
+		Libdbc::DownsampleConfig slow;
+		slow.bucket_ns = 1000 * MS;
+		REQUIRE(downsampler.add_signals("Engine.*", slow) == 2);
+		REQUIRE(downsampler.add_signal("Engine.Rpm"));
+
+		feed(0, 1);
+		feed(150 * MS, 2);
+		REQUIRE(buckets.size() == 1);
+		REQUIRE(buckets[0].signal == parser.find_signal_handle("Engine.Rpm"));
+
+		downsampler.flush();
+		REQUIRE(buckets.size() == 3);
+		REQUIRE(buckets[2].signal == parser.find_signal_handle("Engine.Load"));
+		REQUIRE(buckets[2].count == 2);
+	}
+
+	SECTION("Largest triangle three buckets keeps the peaks") {
+		Libdbc::DownsampleConfig lttb;
+		lttb.mode = Libdbc::DownsampleMode::Lttb;
+		lttb.max_points = 4;
+		downsampler.add_signal("Engine.Rpm", lttb);
+
+		// A flat line with one spike per bucket, 10 samples per bucket
+		for (uint64_t i = 0; i < 40; i++) {
+			feed(i * 10 * MS, (i % 10 == 4) ? 200 : 50);
+		}
+		REQUIRE(buckets.size() == 2); // the third bucket waits for the fourth to complete
+		downsampler.flush();
+		REQUIRE(buckets.size() == 4);
+
+		REQUIRE(buckets[0].point_ns == 0); // the series starts at its first sample
+		REQUIRE(buckets[3].point_ns == 390 * MS); // and ends at its last
+		REQUIRE(buckets[3].point_value == 50);
+		// With 4 candidates the 10 samples are thinned out, the spike at 4 survives as every other sample is dropped
+		REQUIRE(buckets[1].point_value == 200);
+		REQUIRE(buckets[1].point_ns == 140 * MS);
+		REQUIRE(buckets[1].max == 200);
+		REQUIRE(buckets[2].count == 10);
+	}
+}
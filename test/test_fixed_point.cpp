@@ -0,0 +1,155 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/fixed_point.hpp>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Fixed point scales", "[fixed_point]") {
+	auto scale_of = [](double factor, double offset, uint32_t size = 16, bool is_signed = false) {
+		Libdbc::Signal signal("Sig", false, 0, size, false, is_signed, factor, offset, 0, 0, "", std::vector<std::string>{});
+		return Libdbc::FixedPointScale::from_signal(signal);
+	};
+
+	SECTION("Decimal factors") {
+		const auto scale = scale_of(0.1, -40);
+		REQUIRE(scale.exact);
+		REQUIRE(scale.denominator == 10);
+		REQUIRE(scale.multiplier == 1);
+		REQUIRE(scale.addend == -400);
+	}
+
+	SECTION("Binary factors") {
+		const auto scale = scale_of(0.03125, 0);
+		REQUIRE(scale.exact);
+		REQUIRE(scale.denominator == 32);
+		REQUIRE(scale.multiplier == 1);
+	}
+
+	SECTION("Mixed denominators share the smallest common one") {
+		const auto scale = scale_of(0.25, 0.1);
+		REQUIRE(scale.exact);
+		REQUIRE(scale.denominator == 20);
+		REQUIRE(scale.multiplier == 5);
+		REQUIRE(scale.addend == 2);
+	}
+
+	SECTION("Integer factors") {
+		const auto scale = scale_of(2, 5);
+		REQUIRE(scale.exact);
+		REQUIRE(scale.denominator == 1);
+	}
+
+	SECTION("Repeating fractions are approximated") {
+		const auto scale = scale_of(1.0 / 3.0, 0);
+		REQUIRE_FALSE(scale.exact);
+		REQUIRE(Catch::Approx(static_cast<double>(scale.multiplier) / static_cast<double>(scale.denominator)).epsilon(1e-9) == 1.0 / 3.0);
+	}
+
+	SECTION("Scales that would overflow 64 bits are approximated") {
+		const auto scale = scale_of(0.123456789, 0, 40);
+		REQUIRE_FALSE(scale.exact);
+		REQUIRE(scale.fixed_point);
+	}
+
+	SECTION("Wide signals are exact when the scaled range fits") {
+		const auto scale = scale_of(0.5, 0, 63, true);
+		REQUIRE(scale.exact);
+		REQUIRE(scale.denominator == 2);
+		REQUIRE(scale.multiplier == 1);
+	}
+
+	SECTION("A factor of 1 is the raw value at any width") {
+		const auto scale = scale_of(1, 0, 64);
+		REQUIRE(scale.exact);
+		REQUIRE(scale.fixed_point);
+		REQUIRE(scale.multiplier == 1);
+		REQUIRE(scale.addend == 0);
+	}
+
+	SECTION("Signals no scale fits are not fixed point") {
+		const auto scale = scale_of(0.1, 0, 64);
+		REQUIRE_FALSE(scale.exact);
+		REQUIRE_FALSE(scale.fixed_point);
+	}
+}
+
+TEST_CASE("Fixed point decode matches the floating point path", "[fixed_point]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Status: 8 MOTOR
+ SG_ Temperature : 0|8@1+ (0.5,-40) [-40|87.5] "C" DBG
+ SG_ Current : 8|16@1- (0.01,0) [-327.68|327.67] "A" DBG
+ SG_ Voltage : 31|12@0+ (0.125,0) [0|511] "V" DBG
+ SG_ Ratio : 40|16@1+ (0.3333333333,0) [0|1] "" DBG)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.enable_fixed_point();
+	parser.parse_file(filename);
+
+	REQUIRE(parser.get_fixed_point_plans().size() == 1);
+	const auto inexact = parser.inexact_fixed_point_signals();
+	REQUIRE(inexact.size() == 1);
+	REQUIRE(parser.get_signal(inexact.at(0)).name == "Ratio");
+
+	const std::vector<uint8_t> data{0x64, 0x18, 0xFC, 0x12, 0x34, 0x56, 0x78, 0x00};
+	std::vector<double> values;
+	std::vector<int64_t> fixed;
+	REQUIRE(parser.parse_message(100, data, values) == Libdbc::Message::ParseSignalsStatus::Success);
+	REQUIRE(parser.parse_message_fixed(100, data, fixed) == Libdbc::Message::ParseSignalsStatus::Success);
+
+	const auto& scales = parser.get_fixed_point_plans().at(0).scales();
+	REQUIRE(fixed.size() == values.size());
+	for (std::size_t i = 0; i < fixed.size(); i++) {
+		const double physical = static_cast<double>(fixed.at(i)) / static_cast<double>(scales.at(i).denominator);
+		if (scales.at(i).exact) {
+			REQUIRE(physical == Catch::Approx(values.at(i)).epsilon(1e-12));
+		} else {
+			REQUIRE(physical == Catch::Approx(values.at(i)).epsilon(1e-6));
+		}
+	}
+	REQUIRE(fixed.at(0) == 100 - 80); // (100 * 1 - 80) / 2 = 10 C
+	REQUIRE(fixed.at(1) == static_cast<int16_t>(0xFC18));
+
+	SECTION("Disabled by default") {
+		Libdbc::DbcParser plain;
+		plain.parse_file(filename);
+		REQUIRE(plain.get_fixed_point_plans().empty());
+		REQUIRE(plain.parse_message_fixed(100, data, fixed) == Libdbc::Message::ParseSignalsStatus::ErrorUnknownID);
+	}
+}
+
+TEST_CASE("Fixed point decode of 64 bit signals", "[fixed_point]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 200 Counter: 8 MOTOR
+ SG_ Total : 0|64@1+ (1,0) [0|0] "" DBG
+BO_ 201 Wide: 8 MOTOR
+ SG_ Distance : 0|64@1+ (0.25,0) [0|0] "m" DBG
+ SG_ Low : 0|8@1+ (1,0) [0|0] "" DBG)";
+	Libdbc::DbcParser parser;
+	parser.enable_fixed_point();
+	parser.parse_file(create_temporary_dbc_with(dbc_contents.c_str()));
+
+	REQUIRE(parser.inexact_fixed_point_signals().empty());
+	const auto unsupported = parser.unsupported_fixed_point_signals();
+	REQUIRE(unsupported.size() == 1);
+	REQUIRE(parser.get_signal(unsupported.at(0)).name == "Distance");
+
+	SECTION("Counters above 2^53 keep every bit") {
+		std::vector<int64_t> fixed;
+		REQUIRE(parser.parse_message_fixed(200, {0x01, 0, 0, 0, 0, 0, 0x20, 0}, fixed) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(fixed == std::vector<int64_t>{(int64_t(1) << 53) + 1});
+
+		fixed.clear();
+		REQUIRE(parser.parse_message_fixed(200, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}, fixed) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(static_cast<uint64_t>(fixed.at(0)) == UINT64_MAX);
+	}
+
+	SECTION("Unsupported signals are skipped") {
+		std::vector<int64_t> fixed;
+		REQUIRE(parser.parse_message_fixed(201, {0x2A, 0, 0, 0, 0, 0, 0, 0x01}, fixed) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(fixed == std::vector<int64_t>{0, 42});
+	}
+}
@@ -0,0 +1,164 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <string>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+namespace {
+
+struct CountingObserver : public Libdbc::DecodeObserver {
+	std::vector<uint64_t> timestamps;
+
+	void on_decoded(const Libdbc::DecodedMessage& decoded) override {
+		timestamps.push_back(decoded.timestamp_ns);
+	}
+};
+
+}
+
+TEST_CASE("Batch decode of mixed ids", "[batch]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Status: 2 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|255] "" DBG
+ SG_ Mode : 8|8@1+ (1,0) [0|255] "" DBG
+BO_ 200 Command: 1 DRIVER
+ SG_ Throttle : 0|8@1+ (1,0) [0|255] "" MOTOR)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	const uint8_t status_a[] = {1, 2};
+	const uint8_t status_b[] = {3, 4};
+	const uint8_t command_a[] = {5};
+	const uint8_t command_b[] = {6};
+	const uint8_t too_long[] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+	const std::vector<Libdbc::Frame> frames{
+		{200, command_a, sizeof(command_a), 10},
+		{100, status_a, sizeof(status_a), 20},
+		{999, command_a, sizeof(command_a), 30},
+		{200, command_b, sizeof(command_b), 40},
+		{100, too_long, sizeof(too_long), 50},
+		{100, status_b, sizeof(status_b), 60},
+	};
+
+	CountingObserver observer;
+	parser.add_observer(observer);
+
+	Libdbc::BatchResult result;
+
+	SECTION("Results in the original order match per frame decoding") {
+		parser.parse_batch(frames, result);
+
+		REQUIRE(result.frames.size() == frames.size());
+		for (std::size_t i = 0; i < frames.size(); i++) {
+			const auto& decoded = result.frames.at(i);
+			REQUIRE(decoded.frame_index == i);
+
+			std::vector<double> expected;
+			const std::vector<uint8_t> data(frames[i].data, frames[i].data + frames[i].size);
+			REQUIRE(decoded.status == parser.parse_message(frames[i].id, data, expected));
+			REQUIRE(decoded.value_count == expected.size());
+			for (std::size_t value = 0; value < expected.size(); value++) {
+				REQUIRE(result.values.at(decoded.first_value + value) == expected.at(value));
+			}
+		}
+
+		REQUIRE((result.frames.at(2).message_index == Libdbc::DecodedFrame::npos));
+		REQUIRE(result.frames.at(2).status == Libdbc::Message::ParseSignalsStatus::ErrorUnknownID);
+		REQUIRE(result.frames.at(4).status == Libdbc::Message::ParseSignalsStatus::ErrorMessageToLong);
+	}
+
+	SECTION("Grouped results are sorted by message and stable within one") {
+		parser.parse_batch(frames, result, Libdbc::BatchOrder::Grouped);
+
+		REQUIRE(result.permutation == std::vector<std::size_t>{1, 4, 5, 0, 3, 2});
+		REQUIRE(result.group_offsets == std::vector<std::size_t>{0, 3, 5, 6});
+
+		std::vector<std::size_t> order;
+		for (const auto& decoded : result.frames) {
+			order.push_back(decoded.frame_index);
+		}
+		REQUIRE(order == result.permutation);
+
+		REQUIRE(result.frames.at(0).message_index == 0);
+		REQUIRE(result.values.at(result.frames.at(0).first_value) == 1);
+		REQUIRE(result.values.at(result.frames.at(2).first_value + 1) == 4);
+		REQUIRE(result.values.at(result.frames.at(4).first_value) == 6);
+
+		// Observers follow the grouped order and skip failed frames
+		REQUIRE(observer.timestamps == std::vector<uint64_t>{20, 60, 10, 40});
+	}
+
+	SECTION("Results can be reused") {
+		parser.parse_batch(frames, result, Libdbc::BatchOrder::Grouped);
+		parser.parse_batch(frames.data(), 2, result);
+
+		REQUIRE(result.frames.size() == 2);
+		REQUIRE(result.values == std::vector<double>{5, 1, 2});
+	}
+}
+
+TEST_CASE("Batch decode range check", "[batch]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 300 Limits: 2 ECU
+ SG_ Speed : 0|8@1+ (0.1,0) [0|20] "" DBG
+ SG_ Temp : 8|8@1+ (1,-40) [-40|50] "" DBG
+ SG_ Free : 0|8@1+ (1,0) [0|0] "" DBG
+BO_ 400 Wide: 1 ECU
+)";
+	// More signals than fit one mask word, all reading the same bit
+	for (int i = 0; i < 70; i++) {
+		dbc_contents += " SG_ Bit" + std::to_string(i) + " : 0|1@1+ (1,0) [0|0.5] \"\" DBG\n";
+	}
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+	parser.enable_range_check();
+
+	const auto speed = parser.find_signal_handle("Limits.Speed");
+	const auto temp = parser.find_signal_handle("Limits.Temp");
+	const auto free = parser.find_signal_handle("Limits.Free");
+
+	const uint8_t on_limits[] = {200, 0};
+	const uint8_t both_high[] = {201, 100};
+	const uint8_t temp_high[] = {0, 91};
+	const uint8_t bit_set[] = {1};
+	Libdbc::BatchResult result;
+
+	SECTION("Values outside min and max are flagged and counted") {
+		parser.parse_batch({{300, on_limits, 2, 0}, {300, both_high, 2, 0}, {300, temp_high, 2, 0}}, result);
+
+		REQUIRE(result.out_of_range == std::vector<uint64_t>{(1u << 3) | (1u << 4) | (1u << 7)});
+		REQUIRE(parser.range_violations(speed) == 1);
+		REQUIRE(parser.range_violations(temp) == 2);
+		REQUIRE(parser.range_violations(free) == 0);
+
+		parser.parse_batch({{300, temp_high, 2, 0}}, result);
+		REQUIRE(parser.range_violations(temp) == 3);
+
+		parser.reset_range_violations();
+		REQUIRE(parser.range_violations(temp) == 0);
+	}
+
+	SECTION("Flags of a message wider than one word straddle the words") {
+		parser.parse_batch({{300, on_limits, 2, 0}, {400, bit_set, 1, 0}}, result);
+
+		REQUIRE(result.out_of_range == std::vector<uint64_t>{~uint64_t{0} << 3, (uint64_t{1} << 9) - 1});
+		for (int i = 0; i < 70; i++) {
+			REQUIRE(parser.range_violations(parser.find_signal_handle("Wide.Bit" + std::to_string(i))) == 1);
+		}
+	}
+
+	SECTION("Nothing is flagged or counted when disabled") {
+		parser.enable_range_check(false);
+		parser.parse_batch({{300, both_high, 2, 0}}, result);
+
+		REQUIRE(result.out_of_range.empty());
+		REQUIRE(parser.range_violations(speed) == 0);
+	}
+}
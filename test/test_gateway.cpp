@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/gateway.hpp>
+#include <string>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Gateway", "[gateway]") {
+	std::string powertrain_contents = PRIMITIVE_DBC + R"(BO_ 100 EngineData: 8 Vector__XXX
+ SG_ Rpm : 0|16@1+ (0.25,0) [0|16383] "rpm" Vector__XXX
+ SG_ Temperature : 16|8@1- (1,-40) [-168|87] "degC" Vector__XXX
+ SG_ Gear : 24|4@1+ (1,0) [0|15] "" Vector__XXX
+BO_ 101 Unrouted: 1 Vector__XXX
+ SG_ Other : 0|8@1+ (1,0) [0|255] "" Vector__XXX)";
+	std::string body_contents = PRIMITIVE_DBC + R"(BO_ 300 Dashboard: 4 Vector__XXX
+ SG_ EngineSpeed : 7|16@0+ (0.25,0) [0|16383] "rpm" Vector__XXX
+ SG_ Coolant : 23|8@0- (0.5,-20) [0|0] "degC" Vector__XXX
+ SG_ GearIndicator : 24|6@1+ (1,0) [0|63] "" Vector__XXX
+BO_ 301 Cluster: 2 Vector__XXX
+ SG_ Speed : 0|16@1+ (1,0) [0|65535] "rpm" Vector__XXX)";
+	const auto powertrain_file = create_temporary_dbc_with(powertrain_contents.c_str());
+	const auto body_file = create_temporary_dbc_with(body_contents.c_str());
+
+	Libdbc::DbcParser powertrain;
+	powertrain.parse_file(powertrain_file);
+	Libdbc::DbcParser body;
+	body.parse_file(body_file);
+
+	Libdbc::Gateway gateway(powertrain, body);
+	REQUIRE(gateway.add_route("EngineData.Rpm", "Dashboard.EngineSpeed"));
+	REQUIRE(gateway.add_route("EngineData.Temperature", "Dashboard.Coolant"));
+	REQUIRE(gateway.add_route("EngineData.Gear", "Dashboard.GearIndicator"));
+	REQUIRE(gateway.add_route("EngineData.Rpm", "Cluster.Speed"));
+
+	REQUIRE_FALSE(gateway.add_route("EngineData.Missing", "Cluster.Speed"));
+	REQUIRE_FALSE(gateway.add_route("EngineData.Rpm", "Cluster.Missing"));
+
+	SECTION("Routes with the same scaling move the raw bits") {
+		REQUIRE(gateway.route_count() == 4);
+		REQUIRE(gateway.direct_route_count() == 2);
+	}
+
+	SECTION("A frame produces every destination message it feeds") {
+		const std::vector<uint8_t> data{0x10, 0x27, 0x46, 0x03, 0, 0, 0, 0}; // 2500 rpm, 30 degC, gear 3
+		std::vector<Libdbc::Frame> out;
+		REQUIRE(gateway.route(Libdbc::Frame{100, data.data(), data.size(), 42}, out) == 2);
+		REQUIRE(out.size() == 2);
+		REQUIRE(out[0].id == 300);
+		REQUIRE(out[0].timestamp_ns == 42);
+		REQUIRE(out[1].id == 301);
+
+		std::vector<double> values;
+		REQUIRE(body.parse_message(300, std::vector<uint8_t>(out[0].data, out[0].data + out[0].size), values) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(values == std::vector<double>{2500, 30, 3});
+
+		values.clear();
+		REQUIRE(body.parse_message(301, std::vector<uint8_t>(out[1].data, out[1].data + out[1].size), values) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(values == std::vector<double>{2500});
+	}
+
+	SECTION("Values the destination can't hold are clamped") {
+		const std::vector<uint8_t> data{0, 0, 0x7F, 0, 0, 0, 0, 0}; // 87 degC, above the 43.5 degC the destination holds
+		std::vector<Libdbc::Frame> out;
+		gateway.route(Libdbc::Frame{100, data.data(), data.size(), 0}, out);
+
+		std::vector<double> values;
+		body.parse_message(300, std::vector<uint8_t>(out[0].data, out[0].data + out[0].size), values);
+		REQUIRE(values.at(1) == 43.5);
+	}
+
+	SECTION("Frames without routes produce nothing") {
+		const std::vector<uint8_t> data{1};
+		std::vector<Libdbc::Frame> out;
+		REQUIRE(gateway.route(Libdbc::Frame{101, data.data(), data.size(), 0}, out) == 0);
+		REQUIRE(gateway.route(Libdbc::Frame{999, data.data(), data.size(), 0}, out) == 0);
+		REQUIRE(out.empty());
+	}
+}
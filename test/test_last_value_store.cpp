@@ -0,0 +1,105 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <libdbc/dbc.hpp>
+#include <libdbc/last_value_store.hpp>
+#include <thread>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Last value store follows the decode path", "[last_value]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Status: 8 MOTOR
+ SG_ Speed : 0|16@1+ (0.1,0) [0|6553.5] "rpm" DBG
+ SG_ Current : 16|16@1+ (1,0) [0|65535] "A" DBG
+BO_ 200 Command: 2 DRIVER
+ SG_ Throttle : 0|8@1+ (1,0) [0|100] "%" MOTOR)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	Libdbc::LastValueStore store(parser);
+	parser.add_observer(store);
+
+	const auto current = parser.find_signal_handle("Status.Current");
+	const auto throttle = parser.find_signal_handle("Command.Throttle");
+
+	REQUIRE_FALSE(store.read(current).valid);
+
+	std::vector<double> values;
+	REQUIRE(parser.parse_message(100, {0x10, 0x27, 0x2A, 0x00, 0, 0, 0, 0}, values, 1000) == Libdbc::Message::ParseSignalsStatus::Success);
+
+	auto sample = store.read(current);
+	REQUIRE(sample.valid);
+	REQUIRE(sample.value == 42);
+	REQUIRE(sample.timestamp_ns == 1000);
+
+	SECTION("Newer frames replace older values") {
+		REQUIRE(parser.parse_message(100, {0x10, 0x27, 0x2B, 0x00, 0, 0, 0, 0}, values, 2000) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(store.read(current).value == 43);
+		REQUIRE(store.read(current).timestamp_ns == 2000);
+	}
+
+	SECTION("Bulk snapshots return one sample per handle") {
+		std::vector<Libdbc::LastValueStore::Sample> samples;
+		store.snapshot({parser.find_signal_handle("Status.Speed"), current, throttle, Libdbc::SignalHandle()}, samples);
+
+		REQUIRE(samples.size() == 4);
+		REQUIRE(Catch::Approx(samples.at(0).value) == 1000);
+		REQUIRE(samples.at(1).value == 42);
+		REQUIRE_FALSE(samples.at(2).valid);
+		REQUIRE_FALSE(samples.at(3).valid);
+	}
+
+	SECTION("Removed observers are no longer fed") {
+		parser.remove_observer(store);
+		REQUIRE(parser.parse_message(200, {50, 0}, values, 3000) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE_FALSE(store.read(throttle).valid);
+	}
+}
+
+TEST_CASE("Last value readers see whole frames while the writer runs", "[last_value]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Pair: 8 MOTOR
+ SG_ First : 0|32@1+ (1,0) [0|0] "" DBG
+ SG_ Second : 32|32@1+ (1,0) [0|0] "" DBG)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	Libdbc::LastValueStore store(parser);
+	parser.add_observer(store);
+
+	const auto first = parser.find_signal_handle("Pair.First");
+
+	std::atomic<bool> done{false};
+	std::thread writer([&parser, &done]() {
+		std::vector<double> values;
+		for (uint32_t i = 1; i < 20000; i++) {
+			// Both signals always carry the same counter so a torn read shows up as a mismatch
+			std::vector<uint8_t> data{static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8), 0, 0, static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8), 0, 0};
+			values.clear();
+			parser.parse_message(100, data, values, i);
+		}
+		done = true;
+	});
+
+	Libdbc::SignalHandle second(first.message_index, first.signal_index + 1);
+	bool consistent = true;
+	while (!done) {
+		auto a = store.read(first);
+		auto b = store.read(second);
+		if (a.valid && static_cast<uint64_t>(a.value) != (a.timestamp_ns & 0xFFFF)) {
+			consistent = false;
+		}
+		if (b.valid && static_cast<uint64_t>(b.value) != (b.timestamp_ns & 0xFFFF)) {
+			consistent = false;
+		}
+	}
+	writer.join();
+
+	REQUIRE(consistent);
+	REQUIRE(store.read(first).value == 19999);
+}
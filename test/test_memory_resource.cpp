@@ -0,0 +1,153 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/memory_resource.hpp>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+namespace {
+
+struct CountingResource : public Libdbc::MemoryResource {
+	std::size_t allocations = 0;
+	std::size_t deallocations = 0;
+	std::size_t bytes_outstanding = 0;
+
+	void* allocate(std::size_t bytes, std::size_t) override {
+		allocations++;
+		bytes_outstanding += bytes;
+		return ::operator new(bytes);
+	}
+
+	void deallocate(void* pointer, std::size_t bytes, std::size_t) override {
+		deallocations++;
+		bytes_outstanding -= bytes;
+		::operator delete(pointer);
+	}
+};
+
+bool is_aligned(const void* pointer, std::size_t alignment) {
+	return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+}
+
+TEST_CASE("Monotonic resource on a caller buffer", "[memory_resource]") {
+	alignas(16) unsigned char buffer[256];
+	CountingResource upstream;
+	Libdbc::MonotonicResource arena(buffer, sizeof(buffer), upstream);
+
+	void* first = arena.allocate(3, 1);
+	void* second = arena.allocate(8, 8);
+	REQUIRE(first == buffer);
+	REQUIRE(static_cast<unsigned char*>(second) == buffer + 8);
+	REQUIRE(is_aligned(second, 8));
+	REQUIRE(arena.bytes_allocated() == 16);
+	REQUIRE(upstream.allocations == 0);
+
+	SECTION("Overflowing the buffer takes chunks from upstream") {
+		void* large = arena.allocate(1000, 16);
+		REQUIRE(is_aligned(large, 16));
+		REQUIRE(arena.upstream_chunks() == 1);
+		REQUIRE(upstream.allocations == 1);
+
+		arena.release();
+		REQUIRE(upstream.deallocations == 1);
+		REQUIRE(upstream.bytes_outstanding == 0);
+		REQUIRE(arena.bytes_allocated() == 0);
+		REQUIRE(arena.allocate(1, 1) == buffer);
+	}
+
+	SECTION("Deallocating gives nothing back") {
+		arena.deallocate(second, 8, 8);
+		REQUIRE(arena.allocate(1, 1) == buffer + 16);
+	}
+}
+
+TEST_CASE("Monotonic resource growth", "[memory_resource]") {
+	CountingResource upstream;
+	{
+		Libdbc::MonotonicResource arena(64, upstream);
+		Libdbc::Vector<uint32_t> values{Libdbc::Allocator<uint32_t>(arena)};
+		for (uint32_t i = 0; i < 10000; i++) {
+			values.push_back(i);
+		}
+		REQUIRE(values.back() == 9999);
+
+		// Chunks double, so the number taken from upstream stays logarithmic
+		REQUIRE(arena.upstream_chunks() < 16);
+		REQUIRE(upstream.allocations == arena.upstream_chunks());
+	}
+	REQUIRE(upstream.bytes_outstanding == 0);
+}
+
+TEST_CASE("Parser on a memory resource", "[memory_resource]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Status: 2 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|255] "" DBG,MOTOR
+ SG_ Mode : 8|8@1+ (1,0) [0|255] "" DBG
+VAL_ 100 Mode 0 "Off" 1 "On" ;
+CM_ "Not parsed";)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	CountingResource resource;
+	std::unique_ptr<Libdbc::DbcParser> parser(new Libdbc::DbcParser(resource));
+	parser->parse_file(filename);
+
+	const auto& messages = parser->get_messages();
+	REQUIRE(messages.size() == 1);
+	REQUIRE(messages.get_allocator().resource() == &resource);
+	REQUIRE(parser->unused_lines().get_allocator().resource() == &resource);
+
+	const auto& signals = messages.at(0).get_signals();
+	REQUIRE(signals.get_allocator().resource() == &resource);
+	REQUIRE(signals.at(0).receivers.size() == 2);
+	REQUIRE(signals.at(0).receivers.get_allocator().resource() == &resource);
+	REQUIRE(signals.at(1).value_descriptions.size() == 2);
+	REQUIRE(signals.at(1).value_descriptions.get_allocator().resource() == &resource);
+
+	std::vector<double> values;
+	REQUIRE(parser->parse_message(100, {7, 1}, values) == Libdbc::Message::ParseSignalsStatus::Success);
+	REQUIRE(values == std::vector<double>{7, 1});
+
+	REQUIRE(resource.allocations > 0);
+	parser.reset();
+	REQUIRE(resource.bytes_outstanding == 0);
+}
+
+TEST_CASE("Parser on a monotonic arena", "[memory_resource]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Status: 2 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|255] "" DBG)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	CountingResource upstream;
+	Libdbc::MonotonicResource arena(4096, upstream);
+	{
+		Libdbc::DbcParser parser(arena);
+		parser.parse_file(filename);
+		REQUIRE(parser.find_signal("Status.Level") != nullptr);
+		REQUIRE(arena.bytes_allocated() > 0);
+	}
+	arena.release();
+	REQUIRE(upstream.bytes_outstanding == 0);
+}
+
+TEST_CASE("Parsing keeps no waste on a monotonic arena", "[memory_resource]") {
+	const std::string& filename = COMPLEX_DBC_FILE;
+
+	CountingResource counting;
+	Libdbc::DbcParser counted(counting);
+	counted.parse_file(filename);
+	REQUIRE(counting.deallocations == 0);
+
+	// Every vector is allocated once at its final size, so the arena holds what the parser keeps plus alignment
+	Libdbc::MonotonicResource arena;
+	Libdbc::DbcParser parser(arena);
+	parser.parse_file(filename);
+	REQUIRE(arena.bytes_allocated() <= counting.bytes_outstanding + 8 * counting.allocations);
+}
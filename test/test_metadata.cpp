@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <libdbc/dbc.hpp>
+#include <libdbc/metadata.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+namespace {
+
+const std::string METADATA_DBC = PRIMITIVE_DBC + R"(BO_ 100 Status: 2 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|255] "" DBG
+
+CM_ "Whole database";
+CM_ BU_ MOTOR "Engine controller";
+CM_ BO_ 100 "Status of the motor";
+CM_ SG_ 100 Level "Fill level
+spanning two lines";
+BA_DEF_ BO_ "GenMsgSendType" STRING ;
+BA_DEF_DEF_ "GenMsgSendType" "Cyclic";
+BA_DEF_DEF_ "GenSigStartValue" 0;
+BA_ "BusType" "CAN";
+BA_ "NodeLayer" BU_ MOTOR 3;
+BA_ "GenMsgCycleTime" BO_ 100 50;
+BA_ "GenMsgSendType" BO_ 100 "OnChange";
+BA_ "GenSigStartValue" SG_ 100 Level 12;
+SB_ unknown line
+)";
+
+}
+
+TEST_CASE("Comments and attributes are indexed on first use", "[metadata]") {
+	Libdbc::DbcParser parser;
+	parser.parse_file(create_temporary_dbc_with(METADATA_DBC.c_str()));
+
+	const auto& metadata = parser.metadata();
+	REQUIRE_FALSE(metadata.is_indexed());
+	REQUIRE(parser.get_messages().at(0).cycle_time() == 50);
+
+	REQUIRE(*metadata.database_comment() == "Whole database");
+	REQUIRE(metadata.is_indexed());
+	REQUIRE(*metadata.node_comment("MOTOR") == "Engine controller");
+	REQUIRE(*metadata.message_comment(100) == "Status of the motor");
+	REQUIRE(*metadata.signal_comment(100, "Level") == "Fill level\nspanning two lines");
+	REQUIRE(metadata.message_comment(200) == nullptr);
+
+	REQUIRE(*metadata.attribute("BusType") == "CAN");
+	REQUIRE(*metadata.node_attribute("NodeLayer", "MOTOR") == "3");
+	REQUIRE(*metadata.message_attribute("GenMsgCycleTime", 100) == "50");
+	REQUIRE(*metadata.message_attribute("GenMsgSendType", 100) == "OnChange");
+	REQUIRE(*metadata.signal_attribute("GenSigStartValue", 100, "Level") == "12");
+	REQUIRE(metadata.attribute("Missing") == nullptr);
+
+	SECTION("Unset attributes fall back to their default") {
+		REQUIRE(*metadata.message_attribute("GenMsgSendType", 200) == "Cyclic");
+		REQUIRE(*metadata.signal_attribute("GenSigStartValue", 100, "Other") == "0");
+	}
+
+	SECTION("Parsing again starts over") {
+		std::istringstream stream(PRIMITIVE_DBC + "CM_ \"Other database\";\n");
+		parser.parse_file(stream);
+		REQUIRE_FALSE(parser.metadata().is_indexed());
+		REQUIRE(*parser.metadata().database_comment() == "Other database");
+		REQUIRE(parser.metadata().message_comment(100) == nullptr);
+	}
+}
+
+TEST_CASE("Unused line retention", "[metadata]") {
+	const auto filename = create_temporary_dbc_with(METADATA_DBC.c_str());
+	Libdbc::DbcParser parser;
+	parser.enable_parse_report();
+
+	SECTION("Lines are kept by default") {
+		parser.parse_file(filename);
+		REQUIRE(parser.unused_lines().size() == 2);
+		REQUIRE(parser.unused_lines().front().compare(0, 8, "BA_DEF_ ") == 0);
+		REQUIRE(parser.unused_lines().back() == "SB_ unknown line");
+		REQUIRE(parser.unused_line_positions().empty());
+	}
+
+	SECTION("Positions point back into the file") {
+		parser.set_unused_lines(Libdbc::UnusedLines::Positions);
+		parser.parse_file(filename);
+		REQUIRE(parser.unused_lines().empty());
+
+		const auto& positions = parser.unused_line_positions();
+		REQUIRE(positions.size() == 2);
+		REQUIRE(positions.front().line == 17);
+		REQUIRE(positions.back().line == 25);
+
+		const auto last = static_cast<std::size_t>(positions.back().offset);
+		REQUIRE(METADATA_DBC.compare(last, 16, "SB_ unknown line") == 0);
+		REQUIRE(parser.get_parse_report().missed_lines == 2);
+	}
+
+	SECTION("Dropped lines are only counted") {
+		parser.set_unused_lines(Libdbc::UnusedLines::Drop);
+		parser.parse_file(filename);
+		REQUIRE(parser.unused_lines().empty());
+		REQUIRE(parser.unused_line_positions().empty());
+		REQUIRE(parser.get_parse_report().missed_lines == 2);
+		REQUIRE(*parser.metadata().message_comment(100) == "Status of the motor");
+	}
+}
+
+TEST_CASE("Unterminated comments end at the next statement", "[metadata]") {
+	const std::string contents = PRIMITIVE_DBC + R"(CM_ BO_ 100 "path C:\dir\";
+CM_ BO_ 200 "never closed;
+BO_ 100 Status: 2 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|255] "" DBG
+VAL_ 100 Level 1 "Full" 0 "Empty" ;
+CM_ SG_ 100 Level "After";
+)";
+	Libdbc::DbcParser parser;
+	parser.parse_file(create_temporary_dbc_with(contents.c_str()));
+
+	REQUIRE(parser.get_messages().size() == 1);
+	REQUIRE(parser.get_messages().at(0).get_signals().size() == 1);
+	REQUIRE(parser.get_messages().at(0).get_signals().at(0).value_descriptions.size() == 2);
+	REQUIRE(parser.unused_lines().empty());
+
+	const auto& metadata = parser.metadata();
+	REQUIRE(*metadata.message_comment(100) == "path C:\\dir\\");
+	REQUIRE(*metadata.message_comment(200) == "never closed;");
+	REQUIRE(*metadata.signal_comment(100, "Level") == "After");
+}
+
+TEST_CASE("Metadata is indexed once across threads", "[metadata]") {
+	Libdbc::DbcParser parser;
+	parser.parse_file(create_temporary_dbc_with(METADATA_DBC.c_str()));
+	const auto& metadata = parser.metadata();
+
+	std::vector<std::thread> threads;
+	std::atomic<int> found{0};
+	for (int i = 0; i < 8; i++) {
+		threads.emplace_back([&metadata, &found]() {
+			if (metadata.message_comment(100) != nullptr && *metadata.signal_attribute("GenSigStartValue", 100, "Level") == "12") {
+				found++;
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	REQUIRE(found == 8);
+}
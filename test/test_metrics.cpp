@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <libdbc/dbc.hpp>
+#include <libdbc/metrics.hpp>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Decode metrics", "[metrics]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Status: 8 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|100] "%" DBG
+BO_ 200 Other: 8 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|100] "%" DBG)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	Libdbc::Metrics::reset();
+	const auto before = Libdbc::Metrics::snapshot();
+
+	std::vector<double> values;
+	for (int i = 0; i < 3; i++) {
+		parser.parse_message(100, {1, 2, 3}, values);
+	}
+	parser.parse_message(200, {1}, values);
+	parser.parse_message(300, {1}, values);
+	parser.parse_message(100, {1, 2, 3, 4, 5, 6, 7, 8, 9}, values);
+
+	const auto after = Libdbc::Metrics::snapshot();
+
+	if (!Libdbc::Metrics::enabled()) {
+		REQUIRE_FALSE(after.enabled);
+		REQUIRE(after.frames_decoded == 0);
+		REQUIRE(after.frames_per_message.empty());
+		return;
+	}
+
+	REQUIRE(after.enabled);
+	REQUIRE(after.frames_decoded == 4);
+	REQUIRE(after.unknown_id == 1);
+	REQUIRE(after.message_too_long == 1);
+
+	REQUIRE(after.frames_per_message.size() == 2);
+	REQUIRE(after.frames_per_message.at(0).message_id == 100);
+	REQUIRE(after.frames_per_message.at(0).frames == 3);
+	REQUIRE(after.frames_per_message.at(1).frames == 1);
+
+	uint64_t timed = 0;
+	for (auto bucket : after.decode_latency_ns) {
+		timed += bucket;
+	}
+	REQUIRE(timed == 4);
+
+	const auto rates = Libdbc::Metrics::rates(before, after);
+	REQUIRE(rates.size() == 2);
+	REQUIRE(rates.at(0).frames_per_second > rates.at(1).frames_per_second);
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <libdbc/dbc.hpp>
+#include <libdbc/id_filter.hpp>
+#include <libdbc/node_view.hpp>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Id filter never rejects an inserted id", "[node_view]") {
+	Libdbc::IdFilter filter;
+	filter.insert(0x123);
+	filter.insert(0x18FEF100);
+
+	REQUIRE(filter.may_contain(0x123));
+	REQUIRE(filter.may_contain(0x18FEF100));
+	REQUIRE_FALSE(filter.may_contain(0x124));
+
+	filter.clear();
+	REQUIRE_FALSE(filter.may_contain(0x123));
+}
+
+TEST_CASE("Projecting a database onto a node", "[node_view]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 MotorStatus: 8 MOTOR
+ SG_ Speed : 0|16@1+ (0.1,0) [0|6553.5] "rpm" DRIVER
+ SG_ Current : 16|16@1+ (0.01,0) [0|655.35] "A" DBG
+BO_ 200 DriverCommand: 8 DRIVER
+ SG_ Throttle : 0|8@1+ (1,0) [0|100] "%" MOTOR,IO
+ SG_ Brake : 8|8@1+ (1,0) [0|100] "%" IO
+BO_ 300 Debug: 8 DBG
+ SG_ Counter : 0|8@1+ (1,0) [0|255] "" DBG)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	Libdbc::NodeView motor(parser, "MOTOR");
+	REQUIRE(motor.node() == "MOTOR");
+	REQUIRE(motor.plans().size() == 2);
+
+	SECTION("Transmitted messages keep every signal") {
+		const auto* plan = motor.find_plan(100);
+		REQUIRE(plan != nullptr);
+		REQUIRE(plan->signals().size() == 2);
+	}
+
+	SECTION("Received messages keep only the node's signals") {
+		const auto* plan = motor.find_plan(200);
+		REQUIRE(plan != nullptr);
+		REQUIRE(plan->signals().size() == 1);
+		REQUIRE(plan->signals().at(0).signal_index == 0);
+
+		std::vector<double> values;
+		REQUIRE(motor.parse_message(200, {42, 7, 0, 0, 0, 0, 0, 0}, values) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(values.size() == 1);
+		REQUIRE(Catch::Approx(values.at(0)) == 42);
+	}
+
+	SECTION("Unrelated messages are rejected") {
+		REQUIRE_FALSE(motor.accepts(300));
+		REQUIRE_FALSE(motor.accepts(12345));
+
+		std::vector<double> values;
+		REQUIRE(motor.parse_message(300, {1}, values) == Libdbc::Message::ParseSignalsStatus::ErrorUnknownID);
+		REQUIRE(values.empty());
+	}
+
+	SECTION("Views decode the same values as the full database") {
+		std::vector<uint8_t> data{0x10, 0x27, 0xE8, 0x03, 0, 0, 0, 0};
+		std::vector<double> full;
+		std::vector<double> view;
+		REQUIRE(parser.parse_message(100, data, full) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(motor.parse_message(100, data, view) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(full == view);
+	}
+}
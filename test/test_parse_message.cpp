@@ -209,3 +209,118 @@ VAL_ 234 State1 123 "Description 1" 0 "Description 2" 90903489 "Big value and sp
 	REQUIRE(result_values.size() == 1);
 	REQUIRE(Catch::Approx(result_values.at(0)) == 0x1);
 }
+
+TEST_CASE("Parse Message 32 bit unsigned little endian") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 600 COUNTERS: 8 Vector__XXX
+ SG_ Odometer : 0|32@1+ (1,0) [0|4294967295] "m" Vector__XXX
+ SG_ Trip : 32|32@1+ (0.5,0) [0|2147483647] "m" Vector__XXX)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser p;
+	p.parse_file(filename);
+
+	std::vector<uint8_t> data{0x78, 0x56, 0x34, 0xF2, 0x02, 0x00, 0x00, 0x80};
+	std::vector<double> result_values;
+	REQUIRE(p.parse_message(600, data, result_values) == Libdbc::Message::ParseSignalsStatus::Success);
+	REQUIRE(result_values.size() == 2);
+	REQUIRE(result_values.at(0) == 0xF2345678);
+	REQUIRE(result_values.at(1) == 0x80000002 * 0.5);
+}
+
+TEST_CASE("Parse Message byte aligned fields match the generic path") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 700 ALIGNED: 8 Vector__XXX
+ SG_ Byte : 0|8@1- (1,0) [0|0] "" Vector__XXX
+ SG_ Intel16 : 8|16@1+ (1,0) [0|0] "" Vector__XXX
+ SG_ Intel32 : 32|32@1- (1,0) [0|0] "" Vector__XXX
+ SG_ Motorola16 : 15|16@0- (1,0) [0|0] "" Vector__XXX
+ SG_ Motorola32 : 39|32@0+ (1,0) [0|0] "" Vector__XXX
+ SG_ MotorolaByte : 63|8@0+ (1,0) [0|0] "" Vector__XXX
+ SG_ Odd : 12|12@1+ (1,0) [0|0] "" Vector__XXX)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser p;
+	p.parse_file(filename);
+
+	using Layout = Libdbc::SignalPlan::Layout;
+	const auto& plan = p.get_decode_plans().at(0);
+	REQUIRE(plan.signals().at(0).layout == Layout::Byte);
+	REQUIRE(plan.signals().at(1).layout == Layout::LittleEndian16);
+	REQUIRE(plan.signals().at(2).layout == Layout::LittleEndian32);
+	REQUIRE(plan.signals().at(3).layout == Layout::BigEndian16);
+	REQUIRE(plan.signals().at(4).layout == Layout::BigEndian32);
+	REQUIRE(plan.signals().at(5).layout == Layout::Byte);
+	REQUIRE(plan.signals().at(6).layout == Layout::Generic);
+
+	const std::vector<std::vector<uint8_t>> payloads{
+		{0x81, 0x34, 0x12, 0xFE, 0x78, 0x56, 0x34, 0x92},
+		{0x7F, 0xFF, 0xFF, 0x00, 0x01, 0x00, 0x00, 0x80},
+		{0x81, 0x34, 0x12}, // shorter than the signals
+	};
+	for (const auto& data : payloads) {
+		std::vector<double> values;
+		REQUIRE(p.parse_message(700, data, values) == Libdbc::Message::ParseSignalsStatus::Success);
+
+		const auto words = Libdbc::PayloadWords::load(data.data(), data.size());
+		REQUIRE(values.size() == plan.signals().size());
+		for (std::size_t i = 0; i < values.size(); i++) {
+			REQUIRE(values.at(i) == plan.signals().at(i).decode(words));
+		}
+
+		std::vector<double> without_plan;
+		REQUIRE(p.get_messages().at(0).parse_signals(data, without_plan) == Libdbc::Message::ParseSignalsStatus::Success);
+		REQUIRE(without_plan == values);
+	}
+
+	std::vector<double> values;
+	p.parse_message(700, payloads.at(0), values);
+	REQUIRE(values.at(0) == -127);
+	REQUIRE(values.at(1) == 0x1234);
+	REQUIRE(values.at(2) == static_cast<int32_t>(0x92345678));
+	REQUIRE(values.at(3) == 0x3412);
+	REQUIRE(values.at(4) == 0x78563492);
+	REQUIRE(values.at(5) == 0x92);
+}
+
+TEST_CASE("Encoding decoded values gives back the payload") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 710 PACKED: 8 Vector__XXX
+ SG_ Byte : 0|8@1- (1,0) [0|0] "" Vector__XXX
+ SG_ Intel12 : 8|12@1+ (0.5,10) [0|0] "" Vector__XXX
+ SG_ Intel4 : 20|4@1- (1,0) [0|0] "" Vector__XXX
+ SG_ Motorola16 : 31|16@0- (1,0) [0|0] "" Vector__XXX
+ SG_ Motorola10 : 47|10@0+ (1,0) [0|0] "" Vector__XXX
+ SG_ Motorola14 : 53|14@0- (0.25,-3) [0|0] "" Vector__XXX)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser p;
+	p.parse_file(filename);
+	const auto& plan = p.get_decode_plans().at(0);
+
+	const std::vector<std::vector<uint8_t>> payloads{
+		{0x81, 0x34, 0x12, 0xFE, 0x78, 0x56, 0x34, 0x92},
+		{0x7F, 0xFF, 0xFF, 0x00, 0x01, 0x00, 0x00, 0x80},
+		{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+	};
+	for (const auto& data : payloads) {
+		std::vector<double> values;
+		REQUIRE(p.parse_message(710, data, values) == Libdbc::Message::ParseSignalsStatus::Success);
+
+		std::vector<uint8_t> encoded(8, 0);
+		for (std::size_t i = 0; i < values.size(); i++) {
+			REQUIRE(plan.signals().at(i).end_byte() <= 8);
+			plan.signals().at(i).encode(values.at(i), encoded.data());
+		}
+		REQUIRE(encoded == data);
+	}
+
+	SECTION("Values out of range are clamped") {
+		const auto& byte = plan.signals().at(0);
+		REQUIRE(byte.raw_from_physical(1000) == 0x7F);
+		REQUIRE(byte.raw_from_physical(-1000) == 0x80);
+		REQUIRE(byte.raw_from_physical(-1) == 0xFF);
+
+		const auto& intel12 = plan.signals().at(1);
+		REQUIRE(intel12.raw_from_physical(0) == 0);
+		REQUIRE(intel12.raw_from_physical(1e9) == 0xFFF);
+		REQUIRE(intel12.raw_from_physical(11.2) == 2);
+	}
+}
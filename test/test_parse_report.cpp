@@ -0,0 +1,61 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <libdbc/dbc.hpp>
+#include <sstream>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Parse report", "[parse_report]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Status: 8 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|100] "%" DBG
+ SG_ Mode : 8|8@1+ (1,0) [0|3] "" DBG
+BO_ 200 Other: 8 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|100] "%" DBG
+BA_DEF_ BO_ "GenMsgSendType" STRING ;
+CM_ SG_ 100 Level "Tank level";
+VAL_ 100 Mode 0 "Off" 1 "On" 2 "Service with a fairly long description" ;)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	SECTION("Disabled by default") {
+		Libdbc::DbcParser parser;
+		parser.parse_file(filename);
+
+		REQUIRE(parser.get_parse_report().lines == 0);
+		REQUIRE(parser.get_parse_report().total_bytes() == 0);
+	}
+
+	SECTION("Counts lines and memory") {
+		Libdbc::DbcParser parser;
+		parser.enable_parse_report();
+		parser.parse_file(filename);
+
+		const auto& report = parser.get_parse_report();
+		REQUIRE(report.keyword_lines.at("BO_") == 2);
+		REQUIRE(report.keyword_lines.at("SG_") == 3);
+		REQUIRE(report.keyword_lines.at("VAL_") == 1);
+		REQUIRE(report.keyword_lines.at("CM_") == 1);
+		REQUIRE(report.missed_lines == parser.unused_lines().size());
+		REQUIRE(report.missed_lines > 0);
+
+		REQUIRE(report.message_bytes >= 2 * sizeof(Libdbc::Message));
+		REQUIRE(report.signal_bytes >= 3 * sizeof(Libdbc::Signal));
+		REQUIRE(report.value_description_bytes >= 3 * sizeof(Libdbc::Signal::ValueDescription));
+		REQUIRE(report.string_bytes > 0);
+		REQUIRE(report.index_bytes > 0);
+		REQUIRE(report.total_ns >= report.messages_ns);
+
+		std::ostringstream out;
+		out << report;
+		REQUIRE(out.str().find("VAL_: 1") != std::string::npos);
+	}
+
+	SECTION("Report is reset on every parse") {
+		Libdbc::DbcParser parser;
+		parser.enable_parse_report();
+		parser.parse_file(filename);
+		parser.parse_file(filename);
+
+		REQUIRE(parser.get_parse_report().keyword_lines.at("BO_") == 2);
+	}
+}
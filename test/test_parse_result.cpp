@@ -0,0 +1,59 @@
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <libdbc/dbc.hpp>
+#include <libdbc/parse_result.hpp>
+#include <sstream>
+#include <string>
+
+using Catch::Matchers::ContainsSubstring;
+
+TEST_CASE("Parsing without exceptions reports where the file is wrong", "[error][parse_result]") {
+	Libdbc::DbcParser parser;
+
+	SECTION("A correct file parses like the throwing API") {
+		auto result = parser.try_parse_file(SIMPLE_DBC_FILE);
+		REQUIRE(result.ok());
+		REQUIRE(result.message().empty());
+		REQUIRE(parser.get_messages().size() == 1);
+	}
+
+	SECTION("Files without the dbc extension are rejected") {
+		auto result = parser.try_parse_file(TEXT_FILE);
+		REQUIRE(result.error == Libdbc::ParseError::NonDbcFileFormat);
+		REQUIRE(result.line == 0);
+		REQUIRE_THAT(result.message(), ContainsSubstring("TextFile.txt"));
+	}
+
+	SECTION("Files that can't be opened are reported as such") {
+		auto result = parser.try_parse_file(std::string(TESTDBCFILES_PATH) + "/DoesNotExist.dbc");
+		REQUIRE(result.error == Libdbc::ParseError::CannotOpenFile);
+		REQUIRE_THAT(result.context, ContainsSubstring("DoesNotExist.dbc"));
+	}
+
+	SECTION("The missing version points at the first line") {
+		auto result = parser.try_parse_file(MISSING_VERSION_DBC_FILE);
+		REQUIRE(result.error == Libdbc::ParseError::MissingVersion);
+		REQUIRE(result.line == 1);
+		REQUIRE(result.column == 1);
+		REQUIRE(result.context == "NS_ :");
+		REQUIRE_THAT(result.message(), ContainsSubstring("line 1, column 1"));
+	}
+
+	SECTION("The missing bit timing points at the line found instead") {
+		auto result = parser.try_parse_file(MISSING_BIT_TIMING_DBC_FILE);
+		REQUIRE(result.error == Libdbc::ParseError::MissingBitTiming);
+		REQUIRE(result.line == 33);
+		REQUIRE(result.column == 1);
+		REQUIRE(result.context == "BU_: DBG DRIVER IO MOTOR SENSOR");
+	}
+
+	SECTION("Streams report the column of indented keywords") {
+		std::istringstream stream("VERSION \"1.0\"\n\nNS_ :\n\n  BU_: ECU\n");
+		auto result = parser.try_parse_file(stream);
+		REQUIRE(result.error == Libdbc::ParseError::MissingBitTiming);
+		REQUIRE(result.line == 5);
+		REQUIRE(result.column == 3);
+	}
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/replay.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+static constexpr uint64_t MS = 1000000;
+
+TEST_CASE("Replay", "[replay]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Speed: 4 Vector__XXX
+ SG_ Wheel : 0|16@1+ (0.1,0) [0|6553.5] "km/h" Vector__XXX
+ SG_ Counter : 16|8@1+ (1,0) [0|255] "" Vector__XXX
+BO_ 200 Lights: 1 Vector__XXX
+ SG_ Headlights : 0|1@1+ (1,0) [0|1] "" Vector__XXX)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	const std::vector<uint8_t> speed_first{0x10, 0x00, 0x01, 0xAA};
+	const std::vector<uint8_t> speed_second{0x20, 0x00, 0x02, 0xBB};
+	const std::vector<uint8_t> lights{0x01};
+
+	Libdbc::LocalFrameSink sink;
+	Libdbc::Replay replay(parser, sink);
+	// Out of order on purpose, the replay sorts by timestamp
+	replay.add_frame(Libdbc::Frame{100, speed_second.data(), speed_second.size(), 20 * MS});
+	replay.add_frame(Libdbc::Frame{100, speed_first.data(), speed_first.size(), 0});
+	replay.add_frame(Libdbc::Frame{200, lights.data(), lights.size(), 10 * MS});
+	REQUIRE(replay.frame_count() == 3);
+
+	SECTION("Frames go out in timestamp order with their recorded bytes") {
+		replay.run(0);
+		REQUIRE(replay.reencoded_count() == 0);
+
+		const auto& frames = sink.frames();
+		REQUIRE(frames.size() == 3);
+		REQUIRE(frames[0].data == speed_first);
+		REQUIRE(frames[1].data == lights);
+		REQUIRE(frames[2].data == speed_second);
+		REQUIRE(frames[2].timestamp_ns == 20 * MS);
+	}
+
+	SECTION("Only frames of overridden messages are encoded again") {
+		REQUIRE(replay.override_signal("Speed.Wheel", 50));
+		REQUIRE_FALSE(replay.override_signal("Speed.Missing", 1));
+		replay.run(0);
+		REQUIRE(replay.reencoded_count() == 2);
+
+		const auto& frames = sink.frames();
+		// 500 raw, the counter and the unused byte keep their recorded values
+		REQUIRE(frames[0].data == std::vector<uint8_t>{0xF4, 0x01, 0x01, 0xAA});
+		REQUIRE(frames[1].data == lights);
+		REQUIRE(frames[2].data == std::vector<uint8_t>{0xF4, 0x01, 0x02, 0xBB});
+
+		sink.clear();
+		replay.clear_overrides();
+		replay.run(0);
+		REQUIRE(replay.reencoded_count() == 0);
+		REQUIRE(sink.frames()[0].data == speed_first);
+	}
+
+	SECTION("Frames are paced by their timestamps") {
+		// Frames are due relative to the start of run(), not to when the first one went out
+		const auto run_start = static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		replay.run(2.0); // 20 ms of log in 10 ms
+
+		const auto& frames = sink.frames();
+		REQUIRE(frames.size() == 3);
+		REQUIRE(frames[1].sent_ns - run_start >= 5 * MS);
+		REQUIRE(frames[2].sent_ns - run_start >= 10 * MS);
+	}
+
+	SECTION("Stopping wakes a waiting replay and holds until prepared again") {
+		replay.add_frame(Libdbc::Frame{200, lights.data(), lights.size(), 60000 * MS});
+		const auto start = std::chrono::steady_clock::now();
+		std::thread player([&replay]() {
+			replay.run();
+		});
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		replay.stop();
+		player.join();
+		REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+		REQUIRE(sink.frames().size() == 3);
+
+		sink.clear();
+		replay.run(0);
+		REQUIRE(sink.frames().empty());
+
+		replay.prepare();
+		replay.run(0);
+		REQUIRE(sink.frames().size() == 4);
+	}
+
+	SECTION("A stop before run is kept") {
+		replay.stop();
+		replay.run(0);
+		REQUIRE(sink.frames().empty());
+	}
+}
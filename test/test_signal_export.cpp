@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/signal_export.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Signal export", "[export]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Speed: 3 Vector__XXX
+ SG_ Wheel : 0|16@1+ (0.1,0) [0|6553.5] "km/h" Vector__XXX
+ SG_ Counter : 16|8@1+ (1,0) [0|255] "" Vector__XXX
+BO_ 200 Lights: 1 Vector__XXX
+ SG_ Headlights : 0|1@1+ (1,0) [0|1] "" Vector__XXX)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	const std::vector<uint8_t> speed_first{0x10, 0x00, 0x01};
+	const std::vector<uint8_t> lights{0x01};
+	const std::vector<uint8_t> speed_second{0x20, 0x00, 0x02};
+	const std::vector<uint8_t> unknown{0x00};
+	const std::vector<Libdbc::Frame> frames{
+		{100, speed_first.data(), speed_first.size(), 1000},
+		{200, lights.data(), lights.size(), 1500},
+		{999, unknown.data(), unknown.size(), 1700},
+		{100, speed_second.data(), speed_second.size(), 2000},
+	};
+	Libdbc::BatchResult result;
+	parser.parse_batch(frames, result);
+
+	SECTION("CSV rows per decoded value") {
+		std::ostringstream out;
+		{
+			Libdbc::CsvWriter writer(parser, out, 16);
+			writer.write(frames, result);
+		}
+		REQUIRE(out.str() == "timestamp_ns,signal,value\n"
+							 "1000,Speed.Wheel,1.6\n"
+							 "1000,Speed.Counter,1\n"
+							 "1500,Lights.Headlights,1\n"
+							 "2000,Speed.Wheel,3.2\n"
+							 "2000,Speed.Counter,2\n");
+	}
+
+	for (auto encoding : {Libdbc::ColumnEncoding::Plain, Libdbc::ColumnEncoding::Compressed}) {
+		DYNAMIC_SECTION("Columnar round trip, encoding " << static_cast<int>(encoding)) {
+			std::stringstream stream;
+			{
+				// Chunks of one sample so the series spans several chunks
+				Libdbc::ColumnarWriter writer(parser, stream, encoding, 1);
+				writer.write(frames, result);
+				writer.write(0, 500, std::vector<double>{-1e300, 7}.data(), 2);
+			}
+
+			Libdbc::ColumnarReader reader;
+			REQUIRE(reader.read(stream));
+			const auto& columns = reader.columns();
+			REQUIRE(columns.size() == 3);
+			REQUIRE(columns[0].name == "Speed.Wheel");
+			REQUIRE(columns[0].timestamps == std::vector<uint64_t>{1000, 2000, 500});
+			REQUIRE(columns[0].values == std::vector<double>{1.6, 3.2, -1e300});
+			REQUIRE(columns[1].values == std::vector<double>{1, 2, 7});
+			REQUIRE(columns[2].name == "Lights.Headlights");
+			REQUIRE(columns[2].timestamps == std::vector<uint64_t>{1500});
+		}
+	}
+
+	SECTION("Repeated values compress") {
+		std::ostringstream plain_out;
+		std::ostringstream compressed_out;
+		std::size_t plain = 0;
+		std::size_t compressed = 0;
+		{
+			Libdbc::ColumnarWriter plain_writer(parser, plain_out, Libdbc::ColumnEncoding::Plain);
+			Libdbc::ColumnarWriter compressed_writer(parser, compressed_out, Libdbc::ColumnEncoding::Compressed);
+			const double values[] = {12.5, 3};
+			for (uint64_t i = 0; i < 1000; i++) {
+				plain_writer.write(0, i * 10000000, values, 2);
+				compressed_writer.write(0, i * 10000000, values, 2);
+			}
+			plain_writer.flush();
+			compressed_writer.flush();
+			plain = plain_writer.bytes_written();
+			compressed = compressed_writer.bytes_written();
+		}
+		REQUIRE(compressed * 6 < plain);
+	}
+
+	SECTION("Truncated streams are rejected") {
+		std::stringstream stream;
+		{
+			Libdbc::ColumnarWriter writer(parser, stream);
+			writer.write(frames, result);
+		}
+		auto bytes = stream.str();
+		bytes.resize(bytes.size() - 3);
+		std::istringstream truncated(bytes);
+		Libdbc::ColumnarReader reader;
+		REQUIRE_FALSE(reader.read(truncated));
+
+		std::istringstream garbage("not a columnar file");
+		REQUIRE_FALSE(reader.read(garbage));
+	}
+
+	SECTION("Sample counts that don't match the payload are rejected") {
+		for (auto encoding : {Libdbc::ColumnEncoding::Plain, Libdbc::ColumnEncoding::Compressed}) {
+			std::stringstream stream;
+			{
+				Libdbc::ColumnarWriter writer(parser, stream, encoding);
+				writer.write(frames, result);
+			}
+			auto bytes = stream.str();
+
+			// Skip the magic, version, encoding, column count and the names to the first chunk header
+			std::size_t chunk = 10;
+			for (int column = 0; column < bytes[6]; column++) {
+				chunk += 2 + static_cast<uint8_t>(bytes[chunk]);
+			}
+			bytes[chunk + 4] = static_cast<char>(bytes[chunk + 4] + 1);
+			std::istringstream corrupt(bytes);
+			Libdbc::ColumnarReader reader;
+			REQUIRE_FALSE(reader.read(corrupt));
+
+			bytes[chunk + 4] = static_cast<char>(0xFF);
+			bytes[chunk + 7] = static_cast<char>(0xFF);
+			std::istringstream huge(bytes);
+			REQUIRE_FALSE(reader.read(huge));
+		}
+	}
+}
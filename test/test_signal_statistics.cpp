@@ -0,0 +1,103 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <libdbc/dbc.hpp>
+#include <libdbc/signal_statistics.hpp>
+#include <thread>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Streaming statistics per signal", "[statistics]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Status: 2 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|100] "%" DBG
+ SG_ Flags : 8|8@1+ (1,0) [0|0] "" DBG)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	Libdbc::SignalStatistics statistics(parser, 10);
+	parser.add_observer(statistics);
+
+	std::vector<double> values;
+	for (uint8_t level : {2, 4, 4, 4, 5, 5, 7, 9, 100, 200}) {
+		values.clear();
+		REQUIRE(parser.parse_message(100, {level, 1}, values) == Libdbc::Message::ParseSignalsStatus::Success);
+	}
+
+	const auto level = statistics.summary(parser.find_signal_handle("Status.Level"));
+	REQUIRE(level.count == 10);
+	REQUIRE(level.min == 2);
+	REQUIRE(level.max == 200);
+	REQUIRE(Catch::Approx(level.mean) == 34);
+
+	SECTION("Histogram buckets come from the signal range") {
+		REQUIRE(level.buckets.size() == 10);
+		REQUIRE(level.bucket_width == 10);
+		REQUIRE(level.buckets.at(0) == 8);
+		REQUIRE(level.buckets.at(9) == 1); // the upper limit is inclusive
+		REQUIRE(level.overflow == 1);
+		REQUIRE(level.underflow == 0);
+	}
+
+	SECTION("Signals without a range have no histogram") {
+		const auto flags = statistics.summary(parser.find_signal_handle("Status.Flags"));
+		REQUIRE(flags.count == 10);
+		REQUIRE(flags.variance == 0);
+		REQUIRE(flags.buckets.empty());
+	}
+
+	SECTION("Reset clears everything") {
+		statistics.reset();
+		REQUIRE(statistics.summary(parser.find_signal_handle("Status.Level")).count == 0);
+	}
+}
+
+TEST_CASE("Statistics reject signal indices past their message", "[statistics]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 First: 1 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|100] "" DBG
+BO_ 200 Second: 1 MOTOR
+ SG_ Speed : 0|8@1+ (1,0) [0|100] "" DBG)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	Libdbc::SignalStatistics statistics(parser, 10);
+	parser.add_observer(statistics);
+
+	std::vector<double> values;
+	REQUIRE(parser.parse_message(200, {42}, values) == Libdbc::Message::ParseSignalsStatus::Success);
+
+	REQUIRE(statistics.summary(Libdbc::SignalHandle(1, 0)).count == 1);
+	REQUIRE(statistics.summary(Libdbc::SignalHandle(0, 1)).count == 0);
+}
+
+TEST_CASE("Statistics shards from several threads are merged", "[statistics]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Status: 1 MOTOR
+ SG_ Level : 0|8@1+ (1,0) [0|255] "%" DBG)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	Libdbc::SignalStatistics statistics(parser);
+	const auto& message = parser.get_messages().at(0);
+
+	auto feed = [&statistics, &message](double value) {
+		for (int i = 0; i < 1000; i++) {
+			statistics.on_decoded(Libdbc::DecodedMessage{&message, 0, &value, 1, 0});
+		}
+	};
+	std::thread low(feed, 10.0);
+	std::thread high(feed, 20.0);
+	low.join();
+	high.join();
+
+	const auto summary = statistics.summary(Libdbc::SignalHandle(0, 0));
+	REQUIRE(summary.count == 2000);
+	REQUIRE(Catch::Approx(summary.mean) == 15);
+	REQUIRE(Catch::Approx(summary.variance) == 25);
+	REQUIRE(Catch::Approx(summary.stddev) == 5);
+}
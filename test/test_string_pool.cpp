@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <libdbc/dbc.hpp>
+#include <libdbc/string_pool.hpp>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Interning the same text shares storage", "[string_pool]") {
+	Libdbc::StringPool pool;
+
+	auto first = pool.intern("Vector__XXX");
+	auto second = pool.intern(std::string("Vector__XXX"));
+	auto other = pool.intern("km/h");
+
+	REQUIRE(pool.size() == 2);
+	REQUIRE(first == second);
+	REQUIRE(first.c_str() == second.c_str());
+	REQUIRE(first != other);
+	REQUIRE(first == std::string("Vector__XXX"));
+
+	SECTION("Handles outlive the pool") {
+		pool.clear();
+		REQUIRE(pool.size() == 0);
+		REQUIRE(first.str() == "Vector__XXX");
+	}
+}
+
+TEST_CASE("Default and unpooled interned strings", "[string_pool]") {
+	Libdbc::InternedString empty;
+	REQUIRE(empty.empty());
+	REQUIRE(empty == std::string());
+
+	Libdbc::StringPool pool;
+	Libdbc::InternedString unpooled("V");
+	REQUIRE(unpooled == pool.intern("V"));
+	REQUIRE(unpooled.compare("V") == 0);
+}
+
+TEST_CASE("Parsed units and receivers are interned", "[string_pool]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 234 MSG1: 8 Vector__XXX
+ SG_ Sig1 : 0|8@1+ (1,0) [0|200] "km/h" DBG,MOTOR
+ SG_ Sig2 : 8|8@1+ (1,0) [0|200] "km/h" MOTOR,DBG
+BO_ 235 MSG2: 8 Vector__XXX
+ SG_ Sig3 : 0|8@1+ (1,0) [0|200] "km/h" Vector__XXX)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	const auto sig1 = parser.get_messages().at(0).get_signals().at(0);
+	const auto sig2 = parser.get_messages().at(0).get_signals().at(1);
+	const auto sig3 = parser.get_messages().at(1).get_signals().at(0);
+
+	REQUIRE(sig1.unit == "km/h");
+	REQUIRE(sig1.unit.c_str() == sig2.unit.c_str());
+	REQUIRE(sig1.unit.c_str() == sig3.unit.c_str());
+
+	REQUIRE(sig1.receivers.size() == 2);
+	REQUIRE(sig1.receivers.at(0).c_str() == sig2.receivers.at(1).c_str());
+	REQUIRE(sig1.receivers.at(1).c_str() == sig2.receivers.at(0).c_str());
+	REQUIRE(sig3.receivers.at(0) == "Vector__XXX");
+}
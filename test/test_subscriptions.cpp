@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/subscriptions.hpp>
+#include <string>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+TEST_CASE("Signal subscriptions", "[subscriptions]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Engine: 3 Vector__XXX
+ SG_ Rpm : 0|8@1+ (10,0) [0|2550] "" Vector__XXX
+ SG_ Load : 8|8@1+ (1,0) [0|255] "" Vector__XXX
+ SG_ Temperature : 16|8@1+ (1,-40) [-40|215] "" Vector__XXX
+BO_ 200 Lights: 1 Vector__XXX
+ SG_ Headlights : 0|1@1+ (1,0) [0|1] "" Vector__XXX)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	Libdbc::SignalSubscriptions subscriptions(parser);
+	std::vector<std::string> calls;
+	auto record = [&calls, &parser](const std::string& tag) {
+		return [&calls, &parser, tag](const Libdbc::SignalUpdate& update) {
+			calls.push_back(tag + ":" + parser.get_signal(update.signal).name + "=" + std::to_string(static_cast<int>(update.value)) + "@" + std::to_string(update.timestamp_ns));
+		};
+	};
+
+	const std::vector<uint8_t> engine{5, 60, 70};
+	const std::vector<uint8_t> lights{1};
+
+	SECTION("Only subscribed signals are decoded and delivered") {
+		REQUIRE((subscriptions.subscribe("Engine.Temperature", record("a")) != Libdbc::SignalSubscriptions::invalid_id));
+		REQUIRE((subscriptions.subscribe("Engine.Rpm", record("b")) != Libdbc::SignalSubscriptions::invalid_id));
+		REQUIRE((subscriptions.subscribe("Engine.Rpm", record("c")) != Libdbc::SignalSubscriptions::invalid_id));
+		REQUIRE((subscriptions.subscribe("Engine.Missing", record("d")) == Libdbc::SignalSubscriptions::invalid_id));
+		REQUIRE((subscriptions.subscribe(Libdbc::SignalHandle(0, 99), record("e")) == Libdbc::SignalSubscriptions::invalid_id));
+		REQUIRE(subscriptions.subscription_count() == 3);
+
+		REQUIRE(subscriptions.dispatch(Libdbc::Frame{100, engine.data(), engine.size(), 9}));
+		// Signals in message order, subscribers of one signal in subscription order
+		REQUIRE(calls == std::vector<std::string>{"b:Rpm=50@9", "c:Rpm=50@9", "a:Temperature=30@9"});
+	}
+
+	SECTION("Frames without subscribers are rejected") {
+		subscriptions.subscribe("Engine.Load", record("a"));
+		REQUIRE_FALSE(subscriptions.dispatch(Libdbc::Frame{200, lights.data(), lights.size(), 0}));
+		REQUIRE_FALSE(subscriptions.dispatch(Libdbc::Frame{999, lights.data(), lights.size(), 0}));
+		REQUIRE(calls.empty());
+	}
+
+	SECTION("Unsubscribing removes the callback and eventually the id") {
+		const auto rpm = subscriptions.subscribe("Engine.Rpm", record("a"));
+		const auto headlights = subscriptions.subscribe("Lights.Headlights", record("b"));
+
+		REQUIRE(subscriptions.unsubscribe(headlights));
+		REQUIRE_FALSE(subscriptions.unsubscribe(headlights));
+		REQUIRE_FALSE(subscriptions.dispatch(Libdbc::Frame{200, lights.data(), lights.size(), 0}));
+		REQUIRE(subscriptions.dispatch(Libdbc::Frame{100, engine.data(), engine.size(), 0}));
+
+		REQUIRE(subscriptions.unsubscribe(rpm));
+		REQUIRE_FALSE(subscriptions.dispatch(Libdbc::Frame{100, engine.data(), engine.size(), 0}));
+		REQUIRE(calls.size() == 1);
+		REQUIRE(subscriptions.subscription_count() == 0);
+	}
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/timeout_monitor.hpp>
+#include <string>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+static constexpr uint64_t MS = 1000000;
+
+TEST_CASE("Timeout monitor", "[timeout]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 100 Fast: 1 Vector__XXX
+ SG_ State1 : 0|8@1+ (1,0) [0|200] "" Vector__XXX
+BO_ 200 Slow: 1 Vector__XXX
+ SG_ State2 : 0|8@1+ (1,0) [0|200] "" Vector__XXX
+BO_ 300 Event: 1 Vector__XXX
+ SG_ State3 : 0|8@1+ (1,0) [0|200] "" Vector__XXX
+BA_ "GenMsgCycleTime" BO_ 100 10;
+BA_ "GenMsgCycleTime" BO_ 200 60000;)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	std::vector<Libdbc::TimeoutMonitor::Timeout> timeouts;
+	std::vector<uint64_t> fired_at;
+	uint64_t now = 0;
+	Libdbc::TimeoutMonitor monitor(parser, [&](const Libdbc::TimeoutMonitor::Timeout& timeout) {
+		timeouts.push_back(timeout);
+		fired_at.push_back(now);
+	});
+	parser.add_observer(monitor);
+
+	const uint64_t start = 5000 * MS;
+	std::vector<double> values;
+
+	SECTION("Periodic traffic never times out") {
+		for (now = start; now < start + 1000 * MS; now += MS) {
+			if ((now - start) % (10 * MS) == 0) {
+				parser.parse_message(100, {1}, values, now);
+			}
+			monitor.advance(now);
+		}
+		REQUIRE(timeouts.empty());
+		REQUIRE(monitor.armed_count() == 1);
+	}
+
+	SECTION("Fires once on the first tick past the deadline") {
+		parser.parse_message(100, {1}, values, start);
+		parser.parse_message(100, {1}, values, start + 10 * MS);
+
+		for (now = start; now <= start + 200 * MS; now += MS) {
+			monitor.advance(now);
+		}
+		REQUIRE(timeouts.size() == 1);
+		REQUIRE(timeouts.at(0).message->name() == "Fast");
+		REQUIRE(timeouts.at(0).last_seen_ns == start + 10 * MS);
+		REQUIRE(timeouts.at(0).deadline_ns == start + 40 * MS);
+		REQUIRE(fired_at.at(0) == start + 40 * MS);
+		REQUIRE(monitor.is_timed_out(0));
+
+		parser.parse_message(100, {1}, values, now);
+		REQUIRE_FALSE(monitor.is_timed_out(0));
+	}
+
+	SECTION("Long cycle times go through the upper wheel levels") {
+		monitor.arm_all(start);
+		REQUIRE(monitor.armed_count() == 2);
+
+		for (now = start; now <= start + 200000 * MS; now += 7 * MS) {
+			monitor.advance(now);
+		}
+		REQUIRE(timeouts.size() == 2);
+		REQUIRE(timeouts.at(0).message->id() == 100);
+		REQUIRE(timeouts.at(0).last_seen_ns == 0);
+		REQUIRE(timeouts.at(1).message->id() == 200);
+		REQUIRE(timeouts.at(1).deadline_ns == start + 180000 * MS);
+		REQUIRE(fired_at.at(1) >= start + 180000 * MS);
+		REQUIRE(fired_at.at(1) < start + 180007 * MS);
+		REQUIRE_FALSE(monitor.is_timed_out(2));
+	}
+}
+
+TEST_CASE("Timeout monitor with many messages", "[timeout]") {
+	std::string dbc_contents = PRIMITIVE_DBC;
+	for (int i = 0; i < 3000; i++) {
+		const auto id = std::to_string(i + 1);
+		dbc_contents += "BO_ " + id + " Msg" + id + ": 1 Vector__XXX\n SG_ State : 0|8@1+ (1,0) [0|200] \"\" Vector__XXX\n";
+		dbc_contents += "BA_ \"GenMsgCycleTime\" BO_ " + id + " " + std::to_string(10 * (1 + i % 100)) + ";\n";
+	}
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	std::size_t late = 0;
+	std::size_t fired = 0;
+	uint64_t now = 0;
+	Libdbc::TimeoutMonitor monitor(
+		parser,
+		[&](const Libdbc::TimeoutMonitor::Timeout& timeout) {
+			fired++;
+			if (now != timeout.deadline_ns) {
+				late++;
+			}
+		},
+		2.0);
+	parser.add_observer(monitor);
+
+	std::vector<double> values;
+	for (uint32_t id = 1; id <= 3000; id++) {
+		parser.parse_message(id, {1}, values, MS);
+	}
+	REQUIRE(monitor.armed_count() == 3000);
+
+	for (now = MS; now <= 3000 * MS; now += MS) {
+		monitor.advance(now);
+	}
+	REQUIRE(fired == 3000);
+	REQUIRE(late == 0);
+	REQUIRE(monitor.armed_count() == 0);
+}
@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <libdbc/dbc.hpp>
+#include <libdbc/frame_batch.hpp>
+#include <libdbc/transport.hpp>
+#include <string>
+#include <vector>
+
+#include "testing_utils/common.hpp"
+#include "testing_utils/defines.hpp"
+
+static bool feed(Libdbc::TransportReassembler& reassembler, uint32_t id, const std::vector<uint8_t>& data, Libdbc::Transfer& completed, uint64_t timestamp_ns = 0) {
+	return reassembler.feed(Libdbc::Frame{id, data.data(), data.size(), timestamp_ns}, completed);
+}
+
+TEST_CASE("ISO-TP reassembly", "[transport]") {
+	std::string dbc_contents = PRIMITIVE_DBC + R"(BO_ 2024 DiagResponse: 20 Vector__XXX
+ SG_ First : 0|16@1+ (1,0) [0|0] "" Vector__XXX
+ SG_ Odd : 70|12@1+ (1,0) [0|0] "" Vector__XXX
+ SG_ Late : 128|16@1+ (1,0) [0|0] "" Vector__XXX
+ SG_ LateMotorola : 151|16@0+ (1,0) [0|0] "" Vector__XXX)";
+	const auto filename = create_temporary_dbc_with(dbc_contents.c_str());
+	Libdbc::DbcParser parser;
+	parser.parse_file(filename);
+
+	Libdbc::TransportReassembler reassembler;
+	reassembler.add_isotp_id(2024);
+	Libdbc::Transfer completed{};
+
+	SECTION("Segmented payloads are decoded as one message") {
+		REQUIRE_FALSE(feed(reassembler, 2024, {0x10, 20, 0x34, 0x12, 0, 0, 0, 0}, completed));
+		REQUIRE(reassembler.active_sessions() == 1);
+		REQUIRE_FALSE(feed(reassembler, 2024, {0x21, 0, 0, 0xC0, 0x2A, 0, 0, 0}, completed));
+		REQUIRE(feed(reassembler, 2024, {0x22, 0, 0, 0, 0xCD, 0xAB, 0x12, 0x34}, completed, 7));
+		REQUIRE(reassembler.active_sessions() == 0);
+
+		REQUIRE(completed.protocol == Libdbc::TransportProtocol::IsoTp);
+		REQUIRE(completed.id == 2024);
+		REQUIRE(completed.size == 20);
+		REQUIRE(completed.timestamp_ns == 7);
+
+		std::vector<double> values(4);
+		parser.get_decode_plans().at(0).decode_extended(completed.data, completed.size, values.data());
+		REQUIRE(values == std::vector<double>{0x1234, 0xAB, 0xABCD, 0x1234});
+	}
+
+	SECTION("Single frames are handed out in place") {
+		const std::vector<uint8_t> data{0x03, 1, 2, 3, 0, 0, 0, 0};
+		REQUIRE(reassembler.feed(Libdbc::Frame{2024, data.data(), data.size(), 0}, completed));
+		REQUIRE(completed.data == data.data() + 1);
+		REQUIRE(completed.size == 3);
+	}
+
+	SECTION("A wrong sequence number drops the transfer") {
+		REQUIRE_FALSE(feed(reassembler, 2024, {0x10, 20, 0, 0, 0, 0, 0, 0}, completed));
+		REQUIRE_FALSE(feed(reassembler, 2024, {0x22, 0, 0, 0, 0, 0, 0, 0}, completed));
+		REQUIRE(reassembler.dropped() == 1);
+		REQUIRE(reassembler.active_sessions() == 0);
+	}
+
+	SECTION("Other ids are ignored") {
+		REQUIRE_FALSE(feed(reassembler, 2025, {0x03, 1, 2, 3}, completed));
+	}
+}
+
+TEST_CASE("J1939 transport reassembly", "[transport]") {
+	Libdbc::TransportReassembler reassembler;
+	reassembler.enable_j1939();
+	Libdbc::Transfer completed{};
+
+	// Broadcast of 18 bytes for PGN 0xFEE3 from address 0x00 in 3 packets
+	const uint32_t connection = 0x18ECFF00;
+	const uint32_t data_transfer = 0x18EBFF00;
+
+	SECTION("Broadcast announce messages are reassembled") {
+		REQUIRE_FALSE(feed(reassembler, connection, {32, 18, 0, 3, 0xFF, 0xE3, 0xFE, 0x00}, completed));
+		REQUIRE_FALSE(feed(reassembler, data_transfer, {1, 1, 2, 3, 4, 5, 6, 7}, completed));
+		REQUIRE_FALSE(feed(reassembler, data_transfer, {2, 8, 9, 10, 11, 12, 13, 14}, completed));
+		REQUIRE(feed(reassembler, data_transfer, {3, 15, 16, 17, 18, 0xFF, 0xFF, 0xFF}, completed));
+
+		REQUIRE(completed.protocol == Libdbc::TransportProtocol::J1939);
+		REQUIRE(completed.id == 0xFEE3);
+		REQUIRE(completed.source == 0x00);
+		REQUIRE(completed.destination == 0xFF);
+		REQUIRE(std::vector<uint8_t>(completed.data, completed.data + completed.size) == std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18});
+	}
+
+	SECTION("An abort from the receiver ends the connection") {
+		REQUIRE_FALSE(feed(reassembler, 0x18EC2100, {16, 18, 0, 3, 3, 0xE3, 0xFE, 0x00}, completed));
+		REQUIRE(reassembler.active_sessions() == 1);
+		REQUIRE_FALSE(feed(reassembler, 0x18EC0021, {255, 1, 0xFF, 0xFF, 0xFF, 0xE3, 0xFE, 0x00}, completed));
+		REQUIRE(reassembler.active_sessions() == 0);
+		REQUIRE(reassembler.dropped() == 1);
+	}
+
+	SECTION("Stale transfers expire") {
+		REQUIRE_FALSE(feed(reassembler, connection, {32, 18, 0, 3, 0xFF, 0xE3, 0xFE, 0x00}, completed, 1000));
+		reassembler.expire(500000000);
+		REQUIRE(reassembler.active_sessions() == 1);
+		reassembler.expire(2000000000);
+		REQUIRE(reassembler.active_sessions() == 0);
+		REQUIRE_FALSE(feed(reassembler, data_transfer, {1, 1, 2, 3, 4, 5, 6, 7}, completed));
+	}
+}
+
+TEST_CASE("Concurrent transport sessions", "[transport]") {
+	Libdbc::TransportOptions options;
+	options.max_sessions = 300;
+	Libdbc::TransportReassembler reassembler(options);
+	for (uint32_t id = 0; id < 301; id++) {
+		reassembler.add_isotp_id(0x100 + id);
+	}
+	Libdbc::Transfer completed{};
+
+	// Every session gets its first frame before any of them continues
+	for (uint32_t id = 0; id < 301; id++) {
+		feed(reassembler, 0x100 + id, {0x10, 10, static_cast<uint8_t>(id), 0, 0, 0, 0, 0}, completed);
+	}
+	REQUIRE(reassembler.active_sessions() == 300);
+	REQUIRE(reassembler.dropped() == 1);
+
+	std::size_t finished = 0;
+	for (uint32_t id = 0; id < 300; id++) {
+		if (feed(reassembler, 0x100 + id, {0x21, 0, 0, 0, 0, 0, 0, 0}, completed)) {
+			REQUIRE(completed.id == 0x100 + id);
+			REQUIRE(completed.data[0] == static_cast<uint8_t>(id));
+			finished++;
+		}
+	}
+	REQUIRE(finished == 300);
+	feed(reassembler, 0, {}, completed);
+	REQUIRE(reassembler.active_sessions() == 0);
+}
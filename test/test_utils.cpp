@@ -92,4 +92,48 @@ TEST_CASE("Test string split feature", "[string]") {
 	REQUIRE(v == vs);
 }
 
+TEST_CASE("Test string split keeps inner empty tokens", "[string]") {
+	std::string s = "DEVICE1,,DEVICE2,";
+	std::vector<std::string> vs = {"DEVICE1", "", "DEVICE2"};
+
+	std::vector<std::string> v;
+
+	String::split(s, v, ',');
+
+	REQUIRE(v == vs);
+}
+
+TEST_CASE("Test glob matching", "[string]") {
+	REQUIRE(String::glob_match("MSG1.*", "MSG1.Speed"));
+	REQUIRE(String::glob_match("*.Speed", "MSG1.Speed"));
+	REQUIRE(String::glob_match("MSG?.Sp*d", "MSG1.Speed"));
+	REQUIRE(String::glob_match("*", ""));
+	REQUIRE(String::glob_match("exact", "exact"));
+
+	REQUIRE_FALSE(String::glob_match("MSG2.*", "MSG1.Speed"));
+	REQUIRE_FALSE(String::glob_match("MSG?", "MSG12"));
+	REQUIRE_FALSE(String::glob_match("", "a"));
+}
+
+TEST_CASE("Test double formatting", "[string]") {
+	auto format = [](double value) {
+		char text[String::FORMAT_DOUBLE_SIZE];
+		return std::string(text, String::format_double(value, text));
+	};
+
+	REQUIRE(format(0) == "0");
+	REQUIRE(format(42) == "42");
+	REQUIRE(format(-17.5) == "-17.5");
+	REQUIRE(format(0.1) == "0.1");
+	REQUIRE(format(0.05) == "0.05");
+	REQUIRE(format(123.456) == "123.456");
+	REQUIRE(format(1e300) == "1.0000000000000001e+300");
+
+	// Whatever the path, the text parses back to the same value
+	const double values[] = {0.1 * 3, 1.0 / 3, -2.5e-12, 6553.5, 1e16, 4294967295.0, -0.0};
+	for (double value : values) {
+		REQUIRE(String::convert_to_double(format(value)) == value);
+	}
+}
+
 } // Utils
@@ -0,0 +1,25 @@
+#include <iostream>
+#include <libdbc/dbc.hpp>
+#include <libdbc/parse_result.hpp>
+
+// Usage: dbcReport <file.dbc>
+// Parses the file with the parse report enabled and prints it.
+int main(int argc, char** argv) {
+	if (argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <file.dbc>" << std::endl;
+		return 1;
+	}
+
+	Libdbc::DbcParser parser;
+	parser.enable_parse_report();
+
+	auto result = parser.try_parse_file(argv[1]);
+	if (!result.ok()) {
+		std::cerr << argv[1] << ": " << result.message() << std::endl;
+		return 1;
+	}
+
+	std::cout << argv[1] << ": " << parser.get_messages().size() << " messages\n";
+	std::cout << parser.get_parse_report();
+	return 0;
+}